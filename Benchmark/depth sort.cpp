@@ -0,0 +1,59 @@
+//
+//  depth sort.cpp
+//  Benchmark
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <random>
+#include <iostream>
+#include <algorithm>
+#include <Simpleton/Time/benchmark.hpp>
+#include <Simpleton/Graphics 2D/zsort.hpp>
+
+namespace {
+  std::vector<G2D::Quad> makeQuads(const size_t count, std::mt19937 &gen, const bool layers) {
+    std::uniform_real_distribution<float> depthDist{0.0f, 1.0f};
+    std::uniform_int_distribution<int> layerDist{0, 15};
+    std::vector<G2D::Quad> quads(count);
+    for (G2D::Quad &quad : quads) {
+      // depths are either random or a small number of layers like a depth enum
+      const float depth = layers ? layerDist(gen) / 16.0f : depthDist(gen);
+      for (G2D::Vertex &vert : quad) {
+        vert.pos.z = depth;
+      }
+    }
+    return quads;
+  }
+
+  template <typename Compare, typename Key>
+  void benchSort(const char *name, const std::vector<G2D::Quad> &quads, Compare compare, Key key) {
+    std::vector<G2D::Quad> compareSorted = quads;
+    std::vector<G2D::Quad> radixSorted = quads;
+    std::cout << name << '\n';
+    TIME_BENCHMARK(std_sort,
+      std::sort(compareSorted.begin(), compareSorted.end(), compare);
+    )
+    TIME_BENCHMARK(depthSort,
+      G2D::depthSort(radixSorted.data(), radixSorted.data() + radixSorted.size(), key);
+    )
+    for (size_t q = 0; q != quads.size(); ++q) {
+      if (key(compareSorted[q]) != key(radixSorted[q])) {
+        std::cout << "Sorted depths differ\n";
+        break;
+      }
+    }
+  }
+}
+
+int main() {
+  std::mt19937 gen;
+  const std::vector<G2D::Quad> random = makeQuads(50000, gen, false);
+  const std::vector<G2D::Quad> layers = makeQuads(50000, gen, true);
+  benchSort("random sort", random, G2D::sort, G2D::sortKey);
+  benchSort("random sortCenter", random, G2D::sortCenter, G2D::sortCenterKey);
+  benchSort("layers sort", layers, G2D::sort, G2D::sortKey);
+  benchSort("layers sortDeep", layers, G2D::sortDeep, G2D::sortDeepKey);
+  return 0;
+}
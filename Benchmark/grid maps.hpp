@@ -0,0 +1,153 @@
+//
+//  grid maps.hpp
+//  Benchmark
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef grid_maps_hpp
+#define grid_maps_hpp
+
+#include <random>
+#include <Simpleton/Grid/dir.hpp>
+#include <Simpleton/Grid/grid.hpp>
+
+enum class Tile : uint8_t {
+  floor,
+  wall
+};
+
+using Map = Grid::Grid<Tile>;
+
+inline bool notPath(const Tile tile) {
+  return tile == Tile::wall;
+}
+
+/// A mostly empty map with scattered walls
+inline Map openMap(const Grid::Pos size, std::mt19937 &gen) {
+  Map map{size, Tile::floor};
+  std::bernoulli_distribution wall{0.1};
+  for (Tile &tile : map) {
+    if (wall(gen)) {
+      tile = Tile::wall;
+    }
+  }
+  return map;
+}
+
+/// Large empty rooms with a door in every wall between two rooms
+inline Map roomsMap(const Grid::Pos size, std::mt19937 &gen) {
+  constexpr Grid::Coord room = 32;
+  constexpr Grid::Coord door = 3;
+  Map map{size, Tile::floor};
+  for (const Grid::Coord y : map.vert()) {
+    for (const Grid::Coord x : map.hori()) {
+      if (x % room == 0 || y % room == 0) {
+        map(x, y) = Tile::wall;
+      }
+    }
+  }
+  std::uniform_int_distribution<Grid::Coord> doorDist{1, room - door};
+  for (Grid::Coord y = 0; y < size.y; y += room) {
+    for (Grid::Coord x = 0; x < size.x; x += room) {
+      const Grid::Coord hori = doorDist(gen);
+      const Grid::Coord vert = doorDist(gen);
+      for (Grid::Coord d = 0; d != door; ++d) {
+        if (y != 0 && x + hori + d < size.x) {
+          map(x + hori + d, y) = Tile::floor;
+        }
+        if (x != 0 && y + vert + d < size.y) {
+          map(x, y + vert + d) = Tile::floor;
+        }
+      }
+    }
+  }
+  return map;
+}
+
+/// A perfect maze with corridors one tile wide and some walls knocked out so
+/// that there are loops
+inline Map mazeMap(const Grid::Pos size, std::mt19937 &gen) {
+  Map map{size, Tile::wall};
+  const Grid::Pos cells = {(size.x - 1) / 2, (size.y - 1) / 2};
+  const auto toTile = [] (const Grid::Pos cell) {
+    return Grid::Pos{cell.x * 2 + 1, cell.y * 2 + 1};
+  };
+
+  std::vector<Grid::Pos> stack;
+  stack.push_back({0, 0});
+  map[toTile({0, 0})] = Tile::floor;
+  while (!stack.empty()) {
+    const Grid::Pos cell = stack.back();
+    Grid::Dir dirs[4];
+    size_t numDirs = 0;
+    for (const Grid::Dir dir : Grid::dir_range) {
+      const Grid::Pos next = cell + Grid::toVec<Grid::Coord>(dir);
+      if (
+        next.x >= 0 && next.y >= 0 && next.x < cells.x && next.y < cells.y &&
+        map[toTile(next)] == Tile::wall
+      ) {
+        dirs[numDirs++] = dir;
+      }
+    }
+    if (numDirs == 0) {
+      stack.pop_back();
+      continue;
+    }
+    const Grid::Dir dir = dirs[std::uniform_int_distribution<size_t>{0, numDirs - 1}(gen)];
+    const Grid::Pos next = cell + Grid::toVec<Grid::Coord>(dir);
+    map[toTile(cell) + Grid::toVec<Grid::Coord>(dir)] = Tile::floor;
+    map[toTile(next)] = Tile::floor;
+    stack.push_back(next);
+  }
+
+  std::bernoulli_distribution knock{0.05};
+  for (const Grid::Coord y : Utils::range(1, size.y - 1)) {
+    for (const Grid::Coord x : Utils::range(1, size.x - 1)) {
+      if (map(x, y) == Tile::wall && knock(gen)) {
+        map(x, y) = Tile::floor;
+      }
+    }
+  }
+  return map;
+}
+
+/// A single track that winds back and forth across the map like a rail line
+inline Map railMap(const Grid::Pos size) {
+  Map map{size, Tile::wall};
+  for (Grid::Coord y = 1; y < size.y - 1; y += 2) {
+    for (Grid::Coord x = 1; x < size.x - 1; ++x) {
+      map(x, y) = Tile::floor;
+    }
+    if (y + 2 < size.y - 1) {
+      map((y / 2) % 2 == 0 ? size.x - 2 : 1, y + 1) = Tile::floor;
+    }
+  }
+  return map;
+}
+
+/// Random pairs of floor tiles
+inline std::vector<std::pair<Grid::Pos, Grid::Pos>> randomQueries(
+  const Map &map,
+  const size_t count,
+  std::mt19937 &gen
+) {
+  std::uniform_int_distribution<Grid::Coord> xDist{0, map.width() - 1};
+  std::uniform_int_distribution<Grid::Coord> yDist{0, map.height() - 1};
+  const auto randomFloor = [&] () {
+    Grid::Pos pos;
+    do {
+      pos = {xDist(gen), yDist(gen)};
+    } while (map[pos] == Tile::wall);
+    return pos;
+  };
+  std::vector<std::pair<Grid::Pos, Grid::Pos>> queries;
+  queries.reserve(count);
+  for (size_t q = 0; q != count; ++q) {
+    queries.emplace_back(randomFloor(), randomFloor());
+  }
+  return queries;
+}
+
+#endif
@@ -0,0 +1,414 @@
+//
+//  grid pathfinding.cpp
+//  Benchmark
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include "grid maps.hpp"
+#include <iostream>
+#include <unordered_map>
+#include <Simpleton/Time/benchmark.hpp>
+#include <Simpleton/Grid/a star.hpp>
+#include <Simpleton/Grid/jump point search.hpp>
+#include <Simpleton/Grid/hierarchical a star.hpp>
+#include <Simpleton/Grid/flow field.hpp>
+#include <Simpleton/Grid/regions.hpp>
+#include <Simpleton/Grid/distance transform.hpp>
+#include <Simpleton/Grid/path cache.hpp>
+#include <Simpleton/Grid/a star batch.hpp>
+#include <Simpleton/Grid/field of view.hpp>
+#include <Simpleton/Grid/one path.hpp>
+#include <Simpleton/Grid/corridor graph.hpp>
+#include <Simpleton/Grid/cow grid.hpp>
+
+namespace {
+  // the cost of an 8-way path with the costs of EightWay
+  Grid::Coord pathCost(const std::vector<Grid::Pos> &path) {
+    Grid::Coord cost = 0;
+    for (size_t p = 1; p < path.size(); ++p) {
+      const Grid::Pos step = path[p] - path[p - 1];
+      cost += step.x != 0 && step.y != 0 ? Grid::EightWay::diagonal : Grid::EightWay::straight;
+    }
+    return cost;
+  }
+
+  void benchMap(const char *name, const Map &map, std::mt19937 &gen) {
+    const auto queries = randomQueries(map, 64, gen);
+    Grid::AStarWorkspace workspace{map.area()};
+    size_t astarTiles = 0;
+    size_t bitTiles = 0;
+    size_t hpaTiles = 0;
+    Grid::Coord astarCost = 0;
+    Grid::Coord jpsCost = 0;
+    size_t astarExpanded = 0;
+    size_t jpsExpanded = 0;
+
+    std::cout << name << ' ' << map.width() << 'x' << map.height() << '\n';
+    TIME_BENCHMARK(astar,
+      for (const auto &[start, end] : queries) {
+        astarTiles += Grid::astar(workspace, map, notPath, start, end).size();
+      }
+    )
+    const Grid::BitGrid bits = Grid::makeBitGrid(map, notPath);
+    TIME_BENCHMARK(astarBits,
+      for (const auto &[start, end] : queries) {
+        bitTiles += Grid::astar(workspace, bits, start, end).size();
+      }
+    )
+    TIME_BENCHMARK(astarEightWay,
+      for (const auto &[start, end] : queries) {
+        astarCost += pathCost(Grid::astar<Grid::EightWayNoCorners>(workspace, map, notPath, start, end));
+        astarExpanded += workspace.expanded();
+      }
+    )
+    TIME_BENCHMARK(jps,
+      for (const auto &[start, end] : queries) {
+        jpsCost += pathCost(Grid::jps(workspace, map, notPath, start, end));
+        jpsExpanded += workspace.expanded();
+      }
+    )
+    Grid::HierarchicalAStar hpa{map, notPath};
+    TIME_BENCHMARK(hpa,
+      for (const auto &[start, end] : queries) {
+        hpaTiles += hpa.path(start, end).size();
+      }
+    )
+    // agents asking for the same paths every frame
+    Grid::PathCache cache{map.size(), queries.size()};
+    size_t cachedTiles = 0;
+    TIME_BENCHMARK(astarCached,
+      for (int frame = 0; frame != 8; ++frame) {
+        for (const auto &[start, end] : queries) {
+          cachedTiles += cache.path(start, end, 0, [&] (const Grid::Pos s, const Grid::Pos e) {
+            return Grid::astar(workspace, map, notPath, s, e);
+          }).size();
+        }
+      }
+    )
+
+    Grid::AStarBatch batch;
+    std::vector<std::vector<Grid::Pos>> paths;
+    size_t batchTiles = 0;
+    TIME_BENCHMARK(astarBatch,
+      Grid::astarBatch(batch, map, notPath, queries, paths);
+      for (const std::vector<Grid::Pos> &path : paths) {
+        batchTiles += path.size();
+      }
+    )
+
+    if (batchTiles != astarTiles) {
+      std::cout << "Batch path lengths differ " << batchTiles << '\n';
+    }
+    if (cachedTiles != 8 * astarTiles) {
+      std::cout << "Cached path lengths differ " << cachedTiles << '\n';
+    }
+    std::cout << "cache hits " << cache.stats().hits << " misses " << cache.stats().misses << '\n';
+    if (astarTiles != bitTiles) {
+      std::cout << "Path lengths differ " << astarTiles << ' ' << bitTiles << '\n';
+    }
+    if (astarCost != jpsCost) {
+      std::cout << "Path costs differ " << astarCost << ' ' << jpsCost << '\n';
+    }
+    std::cout << "expanded astar " << astarExpanded << " jps " << jpsExpanded << '\n';
+    std::cout << "hpa path length " << (100 * hpaTiles / astarTiles) << "% of optimal\n";
+  }
+
+  // fog of war for lots of units
+  void benchFov(const Map &map, std::mt19937 &gen) {
+    const auto queries = randomQueries(map, 200, gen);
+    std::vector<Grid::Viewer> viewers;
+    for (const auto &query : queries) {
+      viewers.push_back({query.first, 16});
+    }
+    const auto opaque = [] (const Tile tile) {
+      return tile == Tile::wall;
+    };
+    const Grid::BitGrid walls = Grid::makeBitGrid(map, opaque);
+    size_t visible = 0;
+    size_t bitVisible = 0;
+    size_t parallelVisible = 0;
+
+    std::cout << "field of view\n";
+    TIME_BENCHMARK(fov,
+      visible += Grid::fov(map, opaque, viewers).count();
+    )
+    TIME_BENCHMARK(fovBits,
+      bitVisible += Grid::fov(walls, viewers).count();
+    )
+    TIME_BENCHMARK(fovParallel,
+      parallelVisible += Grid::fov(Utils::parallel, map, opaque, viewers).count();
+    )
+
+    if (visible != bitVisible || visible != parallelVisible) {
+      std::cout << "Visible tiles differ " << visible << ' ' << bitVisible << ' ' << parallelVisible << '\n';
+    }
+  }
+
+  // long corridors with few junctions
+  void benchCorridors(Map map, std::mt19937 &gen) {
+    const auto queries = randomQueries(map, 64, gen);
+    std::vector<size_t> oneLengths;
+    std::vector<size_t> graphLengths;
+    size_t graphDist = 0;
+
+    std::cout << "corridors\n";
+    TIME_BENCHMARK(onePath,
+      for (const auto &[start, end] : queries) {
+        oneLengths.push_back(Grid::onePath(map, notPath, start, end).size());
+      }
+    )
+    Grid::CorridorGraph graph{map, notPath};
+    TIME_BENCHMARK(corridorGraph,
+      for (const auto &[start, end] : queries) {
+        graphLengths.push_back(graph.onePath(start, end).size());
+      }
+    )
+    TIME_BENCHMARK(corridorDistance,
+      for (const auto &[start, end] : queries) {
+        graphDist += graph.distance(start, end) + 1;
+      }
+    )
+
+    // onePath gives up if it walks the wrong way down the track
+    size_t graphTiles = 0;
+    for (size_t q = 0; q != queries.size(); ++q) {
+      graphTiles += graphLengths[q];
+      if (oneLengths[q] != 0 && oneLengths[q] != graphLengths[q]) {
+        std::cout << "Path lengths differ " << oneLengths[q] << ' ' << graphLengths[q] << '\n';
+      }
+    }
+    if (graphTiles != graphDist) {
+      std::cout << "Corridor distances differ " << graphTiles << ' ' << graphDist << '\n';
+    }
+
+    // cutting and joining corridors should give the same distances as A* on
+    // the edited map. Most of the edits join corridors because a few cuts
+    // are enough to split the track
+    std::uniform_int_distribution<Grid::Coord> xDist{0, map.width() - 1};
+    std::uniform_int_distribution<Grid::Coord> yDist{0, map.height() - 1};
+    const auto randomTile = [&] (const Tile tile) {
+      Grid::Pos pos;
+      do {
+        pos = {xDist(gen), yDist(gen)};
+      } while (map[pos] != tile);
+      return pos;
+    };
+    std::vector<Grid::Pos> edits;
+    for (int u = 0; u != 256; ++u) {
+      edits.push_back(randomTile(u % 64 == 0 ? Tile::floor : Tile::wall));
+    }
+    TIME_BENCHMARK(updateCorridors,
+      for (const Grid::Pos pos : edits) {
+        graph.setPath(pos, !graph.path(pos));
+      }
+    )
+    for (const Grid::Pos pos : edits) {
+      map[pos] = notPath(map[pos]) ? Tile::floor : Tile::wall;
+    }
+    Grid::AStarWorkspace workspace{map.area()};
+    size_t wrongDist = 0;
+    for (const auto &[start, end] : randomQueries(map, 256, gen)) {
+      Grid::Coord dist = -1;
+      if (!notPath(map[start]) && !notPath(map[end])) {
+        dist = static_cast<Grid::Coord>(Grid::astar(workspace, map, notPath, start, end).size()) - 1;
+      }
+      wrongDist += graph.distance(start, end) != dist;
+    }
+    if (wrongDist != 0) {
+      std::cout << "Updated corridor distances differ from astar " << wrongDist << '\n';
+    }
+  }
+
+  template <typename Layout>
+  void benchLayout(const char *name, const Map &map, std::mt19937 &gen) {
+    Grid::Grid<Tile, Grid::runtime, Grid::runtime, Layout> copy{map.size()};
+    for (const Grid::Coord y : map.vert()) {
+      for (const Grid::Coord x : map.hori()) {
+        copy(x, y) = map(x, y);
+      }
+    }
+    const auto queries = randomQueries(map, 64, gen);
+    Grid::AStarWorkspace workspace{map.area()};
+    size_t tiles = 0;
+
+    std::cout << name << " layout\n";
+    TIME_BENCHMARK(astar,
+      for (const auto &[start, end] : queries) {
+        tiles += Grid::astar(workspace, copy, notPath, start, end).size();
+      }
+    )
+    TIME_BENCHMARK(distanceField,
+      tiles += Grid::distanceField(copy, notPath, {queries[0].first}).area();
+    )
+    TIME_BENCHMARK(flowField,
+      tiles += Grid::flowField(copy, notPath, {queries[0].first}).area();
+    )
+    TIME_BENCHMARK(flowFieldParallel,
+      tiles += Grid::flowField(Utils::parallel, copy, notPath, {queries[0].first}).area();
+    )
+    TIME_BENCHMARK(euclidTransform,
+      tiles += Grid::euclidTransform(copy, notPath).area();
+    )
+    TIME_BENCHMARK(euclidTransformParallel,
+      tiles += Grid::euclidTransform(Utils::parallel, copy, notPath).area();
+    )
+  }
+
+  // the incremental regions should match labelling the grid from scratch
+  bool sameRegions(
+    const Grid::RegionMap &regions,
+    const Map &map,
+    const std::vector<std::pair<Grid::Pos, Grid::Pos>> &queries
+  ) {
+    const auto labels = Grid::labelRegions(map, notPath);
+    // the IDs are different so each label must map to exactly one region
+    std::unordered_map<Grid::RegionID, Grid::RegionID> labelToRegion;
+    std::unordered_map<Grid::RegionID, Grid::RegionID> regionToLabel;
+    for (const Grid::Coord y : map.vert()) {
+      for (const Grid::Coord x : map.hori()) {
+        const Grid::RegionID label = labels(x, y);
+        const Grid::RegionID region = regions.region({x, y});
+        if ((label == Grid::no_region) != (region == Grid::no_region)) {
+          return false;
+        }
+        if (label == Grid::no_region) {
+          continue;
+        }
+        if (
+          labelToRegion.try_emplace(label, region).first->second != region ||
+          regionToLabel.try_emplace(region, label).first->second != label
+        ) {
+          return false;
+        }
+      }
+    }
+    if (labelToRegion.size() != regions.numRegions()) {
+      return false;
+    }
+    for (const auto &[start, end] : queries) {
+      const bool connected = labels[start] != Grid::no_region && labels[start] == labels[end];
+      if (regions.connected(start, end) != connected) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // a wall down the middle means that about half of the queries can't be
+  // reached
+  void benchRegions(Map map, std::mt19937 &gen) {
+    for (const Grid::Coord y : map.vert()) {
+      map(map.width() / 2, y) = Tile::wall;
+    }
+    const auto queries = randomQueries(map, 64, gen);
+    Grid::AStarWorkspace workspace{map.area()};
+    size_t astarTiles = 0;
+    size_t regionTiles = 0;
+    size_t labelled = 0;
+
+    std::cout << "regions\n";
+    TIME_BENCHMARK(astar,
+      for (const auto &[start, end] : queries) {
+        astarTiles += Grid::astar(workspace, map, notPath, start, end).size();
+      }
+    )
+    Grid::RegionMap regions{map, notPath};
+    TIME_BENCHMARK(regionsThenAstar,
+      for (const auto &[start, end] : queries) {
+        if (regions.connected(start, end)) {
+          regionTiles += Grid::astar(workspace, map, notPath, start, end).size();
+        }
+      }
+    )
+    TIME_BENCHMARK(labelRegions,
+      labelled += Grid::labelRegions(map, notPath).area();
+    )
+    std::uniform_int_distribution<Grid::Coord> xDist{0, map.width() - 1};
+    std::uniform_int_distribution<Grid::Coord> yDist{0, map.height() - 1};
+    std::vector<Grid::Pos> edits;
+    for (int u = 0; u != 1024; ++u) {
+      edits.push_back({xDist(gen), yDist(gen)});
+    }
+    TIME_BENCHMARK(updateRegions,
+      for (const Grid::Pos pos : edits) {
+        regions.setPath(pos, !regions.path(pos));
+      }
+    )
+
+    if (astarTiles != regionTiles) {
+      std::cout << "Path lengths differ " << astarTiles << ' ' << regionTiles << '\n';
+    }
+    for (const Grid::Pos pos : edits) {
+      map[pos] = notPath(map[pos]) ? Tile::floor : Tile::wall;
+    }
+    if (!sameRegions(regions, map, queries)) {
+      std::cout << "Updated regions differ from labelRegions\n";
+    }
+  }
+
+  // handing a worker a snapshot instead of a copy of the grid
+  void benchSnapshots(const Map &map, std::mt19937 &gen) {
+    const auto queries = randomQueries(map, 64, gen);
+    Grid::CowGrid<Tile> cow{map};
+    Grid::AStarWorkspace workspace{map.area()};
+    size_t copied = 0;
+    size_t gridTiles = 0;
+    size_t snapTiles = 0;
+    std::uniform_int_distribution<Grid::Coord> xDist{0, map.width() - 1};
+    std::uniform_int_distribution<Grid::Coord> yDist{0, map.height() - 1};
+
+    std::cout << "snapshots\n";
+    TIME_BENCHMARK(copyGrid,
+      copied += Map{map}.area();
+    )
+    TIME_BENCHMARK(takeSnapshot,
+      copied += cow.snapshot().area();
+    )
+    TIME_BENCHMARK(snapshotThenWrite,
+      const auto snapshot = cow.snapshot();
+      for (int w = 0; w != 64; ++w) {
+        const Grid::Pos pos = {xDist(gen), yDist(gen)};
+        cow.set(pos, snapshot[pos]);
+      }
+    )
+    const auto snapshot = cow.snapshot();
+    TIME_BENCHMARK(astarGrid,
+      for (const auto &[start, end] : queries) {
+        gridTiles += Grid::astar(workspace, map, notPath, start, end).size();
+      }
+    )
+    TIME_BENCHMARK(astarSnapshot,
+      for (const auto &[start, end] : queries) {
+        snapTiles += Grid::astar(workspace, snapshot, notPath, start, end).size();
+      }
+    )
+
+    if (gridTiles != snapTiles) {
+      std::cout << "Path lengths differ " << gridTiles << ' ' << snapTiles << '\n';
+    }
+  }
+}
+
+int main() {
+  std::mt19937 gen;
+  benchMap("open", openMap({512, 512}, gen), gen);
+  benchMap("maze", mazeMap({511, 511}, gen), gen);
+  benchMap("rooms", roomsMap({512, 512}, gen), gen);
+  benchRegions(mazeMap({511, 511}, gen), gen);
+  benchFov(mazeMap({511, 511}, gen), gen);
+  benchCorridors(railMap({512, 512}), gen);
+  benchSnapshots(mazeMap({511, 511}, gen), gen);
+
+  const Map wide = openMap({2048, 512}, gen);
+  benchLayout<Grid::RowMajor>("row major", wide, gen);
+  benchLayout<Grid::ZOrder>("z-order", wide, gen);
+  benchLayout<Grid::Tiled<8>>("tiled", wide, gen);
+
+  const Map square = openMap({1024, 1024}, gen);
+  benchLayout<Grid::RowMajor>("square row major", square, gen);
+  benchLayout<Grid::ZOrder>("square z-order", square, gen);
+  benchLayout<Grid::Tiled<8>>("square tiled", square, gen);
+  return 0;
+}
@@ -0,0 +1,315 @@
+//
+//  grid transform.cpp
+//  Benchmark
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <random>
+#include <iostream>
+#include <algorithm>
+#include <Simpleton/Time/benchmark.hpp>
+#include <Simpleton/Grid/transform.hpp>
+#include <Simpleton/Grid/stencil.hpp>
+#include <Simpleton/Grid/neighbor masks.hpp>
+#include <Simpleton/Grid/layered grid.hpp>
+
+namespace {
+  // The transforms as they were before they were blocked and vectorized
+  namespace naive {
+    template <typename Tile>
+    Grid::Grid<Tile> flip_x(const Grid::Grid<Tile> &in) {
+      Grid::Grid<Tile> out{in.size()};
+      for (const Grid::Coord y : in.vert()) {
+        for (const Grid::Coord x : in.hori()) {
+          out(in.width() - x - 1, y) = in(x, y);
+        }
+      }
+      return out;
+    }
+
+    template <typename Tile>
+    void flip_x_inplace(Grid::Grid<Tile> &grid) {
+      for (const Grid::Coord y : grid.vert()) {
+        Tile *const row = grid.data() + static_cast<size_t>(y) * static_cast<size_t>(grid.width());
+        std::reverse(row, row + grid.width());
+      }
+    }
+
+    template <typename Tile>
+    Grid::Grid<Tile> flip_y(const Grid::Grid<Tile> &in) {
+      Grid::Grid<Tile> out{in.size()};
+      for (const Grid::Coord y : in.vert()) {
+        for (const Grid::Coord x : in.hori()) {
+          out(x, in.height() - y - 1) = in(x, y);
+        }
+      }
+      return out;
+    }
+
+    template <typename Tile>
+    Grid::Grid<Tile> transpose(const Grid::Grid<Tile> &in) {
+      Grid::Grid<Tile> out{Grid::Pos{in.height(), in.width()}};
+      for (const Grid::Coord y : in.vert()) {
+        for (const Grid::Coord x : in.hori()) {
+          out(y, x) = in(x, y);
+        }
+      }
+      return out;
+    }
+  }
+
+  template <typename Tile>
+  bool same(const Grid::Grid<Tile> &a, const Grid::Grid<Tile> &b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+  }
+
+  template <typename Tile>
+  void benchTile(const char *name, const Grid::Pos size, std::mt19937 &gen) {
+    Grid::Grid<Tile> grid{size};
+    for (Tile &tile : grid) {
+      tile = static_cast<Tile>(gen());
+    }
+    std::cout << name << ' ' << size.x << 'x' << size.y << '\n';
+
+    Grid::Grid<Tile> naiveOut;
+    Grid::Grid<Tile> out;
+    TIME_BENCHMARK(naive_flip_x, naiveOut = naive::flip_x(grid);)
+    TIME_BENCHMARK(flip_x, out = Grid::flip_x(grid);)
+    if (!same(naiveOut, out)) {
+      std::cout << "flip_x differs\n";
+    }
+    TIME_BENCHMARK(flip_x_inplace, Grid::flip_x_inplace(out);)
+
+    TIME_BENCHMARK(naive_flip_y, naiveOut = naive::flip_y(grid);)
+    TIME_BENCHMARK(flip_y, out = Grid::flip_y(grid);)
+    if (!same(naiveOut, out)) {
+      std::cout << "flip_y differs\n";
+    }
+    TIME_BENCHMARK(flip_y_inplace, Grid::flip_y_inplace(out);)
+
+    TIME_BENCHMARK(naive_transpose, naiveOut = naive::transpose(grid);)
+    TIME_BENCHMARK(transpose, out = Grid::transpose(grid);)
+    if (!same(naiveOut, out)) {
+      std::cout << "transpose differs\n";
+    }
+    TIME_BENCHMARK(transpose_inplace, Grid::transpose_inplace(out);)
+  }
+
+  // a grid that fits in cache so that reversing the rows isn't limited by
+  // memory bandwidth
+  template <typename Tile>
+  void benchReverse(const char *name, const Grid::Pos size, std::mt19937 &gen) {
+    Grid::Grid<Tile> grid{size};
+    for (Tile &tile : grid) {
+      tile = static_cast<Tile>(gen());
+    }
+    Grid::Grid<Tile> naiveGrid = grid;
+    Grid::Grid<Tile> naiveOut;
+    Grid::Grid<Tile> out;
+    std::cout << "reverse " << name << ' ' << size.x << 'x' << size.y << '\n';
+
+    TIME_BENCHMARK(naive_flip_x,
+      for (int r = 0; r != 1000; ++r) {
+        naiveOut = naive::flip_x(grid);
+      }
+    )
+    TIME_BENCHMARK(flip_x,
+      for (int r = 0; r != 1000; ++r) {
+        out = Grid::flip_x(grid);
+      }
+    )
+    if (!same(naiveOut, out)) {
+      std::cout << "flip_x differs\n";
+    }
+    TIME_BENCHMARK(naive_flip_x_inplace,
+      for (int r = 0; r != 1001; ++r) {
+        naive::flip_x_inplace(naiveGrid);
+      }
+    )
+    TIME_BENCHMARK(flip_x_inplace,
+      for (int r = 0; r != 1001; ++r) {
+        Grid::flip_x_inplace(grid);
+      }
+    )
+    if (!same(naiveGrid, grid)) {
+      std::cout << "flip_x_inplace differs\n";
+    }
+  }
+}
+
+namespace {
+  // a lambda so that it can be inlined into the stencil
+  const auto life = [] (const Grid::Neighborhood<uint8_t> &n) -> uint8_t {
+    const int sum = n(-1, -1) + n(0, -1) + n(1, -1) + n(-1, 0) + n(1, 0) + n(-1, 1) + n(0, 1) + n(1, 1);
+    return (sum == 3) | (n.center() & (sum == 2));
+  };
+
+  // Life written the way it was before Stencil
+  Grid::Grid<uint8_t> naiveLife(const Grid::Grid<uint8_t> &in) {
+    Grid::Grid<uint8_t> out{in.size()};
+    for (const Grid::Coord y : in.vert()) {
+      for (const Grid::Coord x : in.hori()) {
+        int sum = 0;
+        for (Grid::Coord dy = -1; dy <= 1; ++dy) {
+          for (Grid::Coord dx = -1; dx <= 1; ++dx) {
+            const Grid::Pos pos = {x + dx, y + dy};
+            if ((dx != 0 || dy != 0) && !in.outOfRange(pos)) {
+              sum += in[pos];
+            }
+          }
+        }
+        out(x, y) = (sum == 3) | (in(x, y) & (sum == 2));
+      }
+    }
+    return out;
+  }
+
+  void benchStencil(const Grid::Pos size, std::mt19937 &gen) {
+    Grid::Grid<uint8_t> grid{size};
+    for (uint8_t &tile : grid) {
+      tile = gen() % 4 == 0;
+    }
+    std::cout << "life " << size.x << 'x' << size.y << '\n';
+
+    Grid::Grid<uint8_t> naiveOut = grid;
+    TIME_BENCHMARK(naive_life,
+      for (int s = 0; s != 16; ++s) {
+        naiveOut = naiveLife(naiveOut);
+      }
+    )
+    Grid::Stencil<uint8_t> stencil{grid};
+    TIME_BENCHMARK(stencil,
+      for (int s = 0; s != 16; ++s) {
+        stencil.step(life);
+      }
+    )
+    if (!same(naiveOut, stencil.grid())) {
+      std::cout << "stencil differs\n";
+    }
+    Grid::Stencil<uint8_t> parallel{grid};
+    TIME_BENCHMARK(stencil_parallel,
+      for (int s = 0; s != 16; ++s) {
+        parallel.step(Utils::parallel, life);
+      }
+    )
+    if (!same(naiveOut, parallel.grid())) {
+      std::cout << "parallel stencil differs\n";
+    }
+
+    // only the blocks around the live tiles are updated
+    Grid::Grid<uint8_t> sparse{size, 0};
+    for (Grid::Coord y = 0; y != 64; ++y) {
+      for (Grid::Coord x = 0; x != 64; ++x) {
+        sparse(size.x / 2 + x, size.y / 2 + y) = gen() % 4 == 0;
+      }
+    }
+    Grid::Stencil<uint8_t> settling{sparse};
+    settling.step(life);
+    std::cout << "active blocks " << settling.activeBlocks() << '\n';
+    TIME_BENCHMARK(stencil_sparse,
+      for (int s = 0; s != 16; ++s) {
+        settling.step(life);
+      }
+    )
+  }
+}
+
+namespace {
+  // masks computed one tile at a time with bounds checks
+  Grid::Grid<Grid::DirBits> naiveMasks(const Grid::Grid<uint8_t> &grid) {
+    Grid::Grid<Grid::DirBits> masks{grid.size()};
+    for (const Grid::Coord y : grid.vert()) {
+      for (const Grid::Coord x : grid.hori()) {
+        Grid::DirBits bits = Grid::DirBits::none;
+        for (const Grid::Dir dir : Grid::dir_range) {
+          const Grid::Pos neigh = Grid::Pos{x, y} + Grid::toVec<Grid::Coord>(dir);
+          if (!grid.outOfRange(neigh) && grid[neigh]) {
+            bits = Grid::set(bits, dir);
+          }
+        }
+        masks(x, y) = bits;
+      }
+    }
+    return masks;
+  }
+
+  void benchMasks(const Grid::Pos size, std::mt19937 &gen) {
+    Grid::Grid<uint8_t> grid{size};
+    for (uint8_t &tile : grid) {
+      tile = gen() % 2;
+    }
+    const auto pred = [] (const uint8_t tile) {
+      return tile != 0;
+    };
+    std::cout << "masks " << size.x << 'x' << size.y << '\n';
+
+    Grid::Grid<Grid::DirBits> naiveOut;
+    Grid::Grid<Grid::DirBits> out;
+    TIME_BENCHMARK(naive_masks, naiveOut = naiveMasks(grid);)
+    TIME_BENCHMARK(neighborMasks, out = Grid::neighborMasks(grid, pred);)
+    if (!same(naiveOut, out)) {
+      std::cout << "neighborMasks differs\n";
+    }
+    TIME_BENCHMARK(cornerMasks, Grid::cornerMasks(grid, pred);)
+    TIME_BENCHMARK(updateNeighborMasks,
+      for (int u = 0; u != 1024; ++u) {
+        const Grid::Pos pos = {
+          static_cast<Grid::Coord>(gen() % static_cast<unsigned>(size.x)),
+          static_cast<Grid::Coord>(gen() % static_cast<unsigned>(size.y))
+        };
+        grid[pos] ^= 1;
+        Grid::updateNeighborMasks(out, grid, pred, pos);
+      }
+    )
+  }
+}
+
+namespace {
+  struct FatTile {
+    uint8_t terrain;
+    float cost;
+    int32_t owner;
+    float light[4];
+  };
+
+  void benchLayers(const Grid::Pos size, std::mt19937 &gen) {
+    Grid::Grid<FatTile> aos{size};
+    for (FatTile &tile : aos) {
+      tile.terrain = static_cast<uint8_t>(gen() % 4);
+      tile.cost = static_cast<float>(gen() % 8);
+    }
+    const auto soa = Grid::makeLayeredGrid(aos, &FatTile::terrain, &FatTile::cost, &FatTile::owner);
+    std::cout << "layers " << size.x << 'x' << size.y << '\n';
+
+    float aosCost = 0.0f;
+    float soaCost = 0.0f;
+    TIME_BENCHMARK(aos_sum_cost,
+      for (const FatTile &tile : aos) {
+        aosCost += tile.cost;
+      }
+    )
+    TIME_BENCHMARK(layered_sum_cost,
+      for (const float cost : soa.layer<float>()) {
+        soaCost += cost;
+      }
+    )
+    if (aosCost != soaCost) {
+      std::cout << "layered sum differs\n";
+    }
+  }
+}
+
+int main() {
+  std::mt19937 gen;
+  benchTile<uint8_t>("uint8_t", {4096, 4096}, gen);
+  benchTile<uint32_t>("uint32_t", {4096, 4096}, gen);
+  benchTile<uint32_t>("uint32_t", {4096, 2048}, gen);
+  benchReverse<uint8_t>("uint8_t", {512, 512}, gen);
+  benchReverse<uint32_t>("uint32_t", {512, 128}, gen);
+  benchStencil({2048, 2048}, gen);
+  benchMasks({4096, 4096}, gen);
+  benchLayers({4096, 4096}, gen);
+  return 0;
+}
@@ -10,23 +10,60 @@
 #define engine_graphics_2d_geom_types_hpp
 
 #include <array>
+#include <cassert>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/common.hpp>
 #include "../Type List/type.hpp"
 
 namespace G2D {
   using PosType = glm::vec3;
+  #ifdef G2D_PACKED_VERTICES
+  // normalized by the attribute pointer
+  using TexCoordType = glm::tvec2<uint16_t>;
+  using ColorType = glm::tvec4<uint8_t>;
+  #else
   using TexCoordType = glm::vec2;
   using ColorType = glm::vec4;
+  #endif
   using ElemType = uint16_t;
   
+  /// Convert texture coordinates from 0-1 to the vertex format. Packed
+  /// coordinates cover the length of the texture with 16 bits so they can't
+  /// repeat a texture. Asserts if packed coordinates are outside of 0-1
+  inline TexCoordType packTexCoord(const glm::vec2 texCoord) {
+    #ifdef G2D_PACKED_VERTICES
+    // allow for rounding errors
+    assert(-0.001f <= texCoord.x && texCoord.x <= 1.001f);
+    assert(-0.001f <= texCoord.y && texCoord.y <= 1.001f);
+    return TexCoordType(glm::clamp(texCoord, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    #else
+    return texCoord;
+    #endif
+  }
+  
+  /// Convert a color from 0-1 to the vertex format
+  inline ColorType packColor(const glm::vec4 color) {
+    #ifdef G2D_PACKED_VERTICES
+    return ColorType(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+    #else
+    return color;
+    #endif
+  }
+  
   struct Vertex {
     PosType pos;
     TexCoordType texCoord;
-    ColorType color {1.0f};
+    ColorType color = packColor(glm::vec4{1.0f});
   };
   
+  #ifdef G2D_PACKED_VERTICES
+  static_assert(sizeof(Vertex) == 20);
+  #else
+  static_assert(sizeof(Vertex) == 36);
+  #endif
+  
   using Quad = std::array<Vertex, 4>;
   
   constexpr size_t QUAD_INDICIES = 6;
@@ -35,6 +72,20 @@ namespace G2D {
   constexpr size_t QUAD_ELEM_SIZE = sizeof(ElemType) * QUAD_INDICIES;
   
   using Attribs = List::Type<PosType, TexCoordType, ColorType>;
+  
+  /// A quad that is drawn with instanced rendering. The vertex shader creates
+  /// the corners so this is about a third of the size of a Quad. The quad is
+  /// positioned relative to its bottom left corner and rotated around its
+  /// center like Section::rotTilePos
+  struct QuadInstance {
+    glm::vec2 pos;
+    glm::vec2 size {1.0f, 1.0f};
+    glm::vec2 texMin;
+    glm::vec2 texMax;
+    float angle = 0.0f;
+    float depth = 0.0f;
+    glm::tvec4<uint8_t> color {255, 255, 255, 255};
+  };
 }
 
 #endif
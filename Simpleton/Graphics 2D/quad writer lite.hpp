@@ -10,6 +10,7 @@
 #define engine_graphics_2d_quad_writer_lite_hpp
 
 #include "depth.hpp"
+#include "zsort.hpp"
 #include "renderer.hpp"
 #include "../Math/rect.hpp"
 
@@ -31,6 +32,11 @@ namespace G2D {
     /// Sort the quads in the current section by the given sorting predicate
     template <typename Function>
     void sort(Function &&);
+    /// Sort the quads in the current section from deepest to shallowest with
+    /// a radix sort. The function should be one of the depth key functions
+    /// like sortKey
+    template <typename Function>
+    void depthSort(Function &&);
     
     /// Start a new quad and return it
     Quad &quad();
@@ -46,11 +52,15 @@ namespace G2D {
     void tilePos(glm::vec2, glm::vec2 = {1.0f, 1.0f});
     
     /// Write texture coordinates of vertices on the current quad assuming that
-    /// the texture is sampled as an axis-aligned rectangle
+    /// the texture is sampled as an axis-aligned rectangle. With
+    /// G2D_PACKED_VERTICES the coordinates must be within 0-1 so
+    /// TexWrap::REPEAT can't be used to repeat the texture across the quad
     template <PlusXY PLUS_XY = PlusXY::RIGHT_UP>
     void tileTex(glm::vec2, glm::vec2);
     /// Write texture coordinates of vertices on the current quad assuming that
-    /// the texture is sampled as an axis-aligned rectangle
+    /// the texture is sampled as an axis-aligned rectangle. With
+    /// G2D_PACKED_VERTICES the coordinates must be within 0-1 so
+    /// TexWrap::REPEAT can't be used to repeat the texture across the quad
     template <PlusXY PLUS_XY = PlusXY::RIGHT_UP>
     void tileTex(Math::RectPP<float>);
     
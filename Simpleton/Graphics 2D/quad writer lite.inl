@@ -6,6 +6,8 @@
 //  Copyright © 2018 Indi Kernick. All rights reserved.
 //
 
+#include <algorithm>
+
 inline G2D::QuadWriterLite::QuadWriterLite() {
   quads.reserve(2048);
   sections.reserve(64);
@@ -43,6 +45,12 @@ void G2D::QuadWriterLite::sort(Function &&function) {
   );
 }
 
+template <typename Function>
+void G2D::QuadWriterLite::depthSort(Function &&key) {
+  assert(sections.size());
+  G2D::depthSort(quads.data() + sections.back(), quads.data() + quads.size(), key);
+}
+
 inline G2D::Quad &G2D::QuadWriterLite::quad() {
   assert(sections.size());
   return quads.emplace_back();
@@ -97,10 +105,10 @@ void G2D::QuadWriterLite::tileTex(const glm::vec2 min, const glm::vec2 max) {
   constexpr size_t i = static_cast<size_t>(PLUS_XY);
   
   Quad &quad = quads.back();
-  quad[Is[i][0]].texCoord = min;
-  quad[Is[i][1]].texCoord = {max.x, min.y};
-  quad[Is[i][2]].texCoord = max;
-  quad[Is[i][3]].texCoord = {min.x, max.y};
+  quad[Is[i][0]].texCoord = packTexCoord(min);
+  quad[Is[i][1]].texCoord = packTexCoord({max.x, min.y});
+  quad[Is[i][2]].texCoord = packTexCoord(max);
+  quad[Is[i][3]].texCoord = packTexCoord({min.x, max.y});
 }
 
 template <G2D::PlusXY PLUS_XY>
@@ -115,7 +123,7 @@ inline void G2D::QuadWriterLite::color(const glm::vec4 color) {
   quad[0].color =
   quad[1].color =
   quad[2].color =
-  quad[3].color = color;
+  quad[3].color = packColor(color);
 }
 
 inline void G2D::QuadWriterLite::colorWhite() {
@@ -132,17 +140,31 @@ inline void G2D::QuadWriterLite::append(const QuadWriterLite &writer) {
 }
 
 inline void G2D::QuadWriterLite::render(Renderer &renderer) const {
-  renderer.writeQuads({0, quads.size()}, quads.data());
-  if (sections.empty()) {
+  if (quads.empty()) {
     return;
   }
+  const bool streaming = renderer.streaming();
+  size_t offset = 0;
+  if (streaming) {
+    std::copy(quads.cbegin(), quads.cend(), renderer.streamQuads(quads.size()));
+    offset = renderer.flushStream().begin;
+  } else {
+    renderer.writeQuads({0, quads.size()}, quads.data());
+  }
+  const auto draw = [&] (const QuadRange range, const RenderParams &sectionParams) {
+    if (streaming) {
+      renderer.renderStream(range, sectionParams);
+    } else {
+      renderer.render(range, sectionParams);
+    }
+  };
   QuadRange range;
-  range.begin = sections[0];
+  range.begin = offset + sections[0];
   for (size_t s = 1; s != sections.size(); ++s) {
-    range.end = sections[s];
-    renderer.render(range, params[s - 1]);
+    range.end = offset + sections[s];
+    draw(range, params[s - 1]);
     range.begin = range.end;
   }
-  range.end = quads.size();
-  renderer.render(range, params.back());
+  range.end = offset + quads.size();
+  draw(range, params.back());
 }
@@ -10,6 +10,7 @@
 #define engine_graphics_2d_quad_writer_hpp
 
 #include "depth.hpp"
+#include "zsort.hpp"
 #include "renderer.hpp"
 #include "sheet tex.hpp"
 
@@ -42,6 +43,10 @@ namespace G2D {
     /// Sort the quads by the given sorting predicate
     template <typename Function>
     void sort(Function &&);
+    /// Sort the quads from deepest to shallowest with a radix sort. The
+    /// function should be one of the depth key functions like sortKey
+    template <typename Function>
+    void depthSort(Function &&);
   
     /// Create a new quad
     Quad &quad();
@@ -80,11 +85,15 @@ namespace G2D {
     /// the current quad
     void dupTex();
     /// Write texture coordinates of vertices on the current quad assuming that
-    /// the texture is sampled as an axis-aligned rectangle
+    /// the texture is sampled as an axis-aligned rectangle. With
+    /// G2D_PACKED_VERTICES the coordinates must be within 0-1 so
+    /// TexWrap::REPEAT can't be used to repeat the texture across the quad
     template <PlusXY PLUS_XY = PlusXY::RIGHT_UP>
     void tileTex(glm::vec2, glm::vec2);
     /// Write texture coordinates of vertices on the current quad assuming that
-    /// the texture is sampled as an axis-aligned rectangle
+    /// the texture is sampled as an axis-aligned rectangle. With
+    /// G2D_PACKED_VERTICES the coordinates must be within 0-1 so
+    /// TexWrap::REPEAT can't be used to repeat the texture across the quad
     template <PlusXY PLUS_XY = PlusXY::RIGHT_UP>
     void tileTex(Math::RectPP<float>);
     /// Write texture coordinates of vertices on the current quad assuming that
@@ -114,6 +123,8 @@ namespace G2D {
     void render(Renderer &) const;
     
   private:
+    friend class QuadWriter;
+  
     RenderParams renderParams;
     const Sprite::Sheet &spriteSheet;
     std::vector<Quad> quads;
@@ -132,11 +143,17 @@ namespace G2D {
     /// section with the same params.
     Section &section(const glm::mat3 &, const SheetTex &);
     
-    /// Render all of the sections
-    void render(Renderer &) const;
+    /// Render all of the sections. The quads of every section are copied into
+    /// GPU memory with one upload and then each section is drawn from its own
+    /// offset. If the renderer is streaming, the quads are copied straight
+    /// into the stream. Returns the number of sync points that were avoided
+    /// compared to uploading and drawing each section separately
+    size_t render(Renderer &) const;
     
   private:
     std::vector<Section> sections;
+    // the quads of every section laid out back-to-back
+    mutable std::vector<Quad> staging;
   };
 }
 
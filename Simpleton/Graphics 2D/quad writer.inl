@@ -39,6 +39,11 @@ void G2D::Section::sort(Function &&function) {
   );
 }
 
+template <typename Function>
+void G2D::Section::depthSort(Function &&key) {
+  G2D::depthSort(quads.data(), quads.data() + quads.size(), key);
+}
+
 inline G2D::Quad &G2D::Section::quad() {
   return quads.emplace_back();
 }
@@ -201,10 +206,10 @@ void G2D::Section::tileTex(const glm::vec2 min, const glm::vec2 max) {
   constexpr size_t i = static_cast<size_t>(PLUS_XY);
   
   Quad &quad = quads.back();
-  quad[Is[i][0]].texCoord = min;
-  quad[Is[i][1]].texCoord = {max.x, min.y};
-  quad[Is[i][2]].texCoord = max;
-  quad[Is[i][3]].texCoord = {min.x, max.y};
+  quad[Is[i][0]].texCoord = packTexCoord(min);
+  quad[Is[i][1]].texCoord = packTexCoord({max.x, min.y});
+  quad[Is[i][2]].texCoord = packTexCoord(max);
+  quad[Is[i][3]].texCoord = packTexCoord({min.x, max.y});
 }
 
 template <G2D::PlusXY PLUS_XY>
@@ -231,7 +236,7 @@ inline void G2D::Section::whitepixel() {
   quad[0].texCoord =
   quad[1].texCoord =
   quad[2].texCoord = 
-  quad[3].texCoord = whitepixel;
+  quad[3].texCoord = packTexCoord(whitepixel);
 }
 
 inline void G2D::Section::color(const glm::vec4 color) {
@@ -241,16 +246,19 @@ inline void G2D::Section::color(const glm::vec4 color) {
   quad[0].color =
   quad[1].color =
   quad[2].color =
-  quad[3].color = color;
+  quad[3].color = packColor(color);
 }
 
 inline void G2D::Section::colorWhite() {
   color({1.0f, 1.0f, 1.0f, 1.0f});
 }
 
-inline void G2D::Section::xGradient(const glm::vec4 low, const glm::vec4 high) {
+inline void G2D::Section::xGradient(const glm::vec4 lowColor, const glm::vec4 highColor) {
   assert(!quads.empty());
   
+  const ColorType low = packColor(lowColor);
+  const ColorType high = packColor(highColor);
+  
   Quad &quad = quads.back();
   quad[0].color = low;
   quad[1].color = high;
@@ -258,9 +266,12 @@ inline void G2D::Section::xGradient(const glm::vec4 low, const glm::vec4 high) {
   quad[3].color = low;
 }
 
-inline void G2D::Section::yGradient(const glm::vec4 low, const glm::vec4 high) {
+inline void G2D::Section::yGradient(const glm::vec4 lowColor, const glm::vec4 highColor) {
   assert(!quads.empty());
   
+  const ColorType low = packColor(lowColor);
+  const ColorType high = packColor(highColor);
+  
   Quad &quad = quads.back();
   quad[0].color = low;
   quad[1].color = low;
@@ -301,8 +312,48 @@ inline G2D::Section &G2D::QuadWriter::section(
   return sections.emplace_back(params, sheetTex.sheet());
 }
 
-inline void G2D::QuadWriter::render(Renderer &renderer) const {
+inline size_t G2D::QuadWriter::render(Renderer &renderer) const {
+  size_t numQuads = 0;
+  for (const Section &section : sections) {
+    numQuads += section.quads.size();
+  }
+  if (numQuads == 0) {
+    return 0;
+  }
+  
+  // writing every section to offset 0 would mean that each draw has to
+  // finish before the buffer can be overwritten for the next section
+  const bool streaming = renderer.streaming();
+  Quad *dst;
+  if (streaming) {
+    dst = renderer.streamQuads(numQuads);
+  } else {
+    staging.resize(numQuads);
+    dst = staging.data();
+  }
+  for (const Section &section : sections) {
+    dst = std::copy(section.quads.cbegin(), section.quads.cend(), dst);
+  }
+  QuadRange range {0, numQuads};
+  if (streaming) {
+    range = renderer.flushStream();
+  } else {
+    renderer.writeQuads(range, staging.data());
+  }
+  
+  size_t draws = 0;
   for (const Section &section : sections) {
-    section.render(renderer);
+    if (section.quads.empty()) {
+      continue;
+    }
+    range.end = range.begin + section.quads.size();
+    if (streaming) {
+      renderer.renderStream(range, section.renderParams);
+    } else {
+      renderer.render(range, section.renderParams);
+    }
+    range.begin = range.end;
+    ++draws;
   }
+  return draws - 1;
 }
@@ -9,10 +9,13 @@
 #ifndef engine_graphics_2d_renderer_hpp
 #define engine_graphics_2d_renderer_hpp
 
+#include <array>
+#include <limits>
 #include <vector>
 #include "types.hpp"
 #include "surface.hpp"
 #include <string_view>
+#include "../OpenGL/fence.hpp"
 #include "../OpenGL/buffer.hpp"
 #include "../OpenGL/texture.hpp"
 #include "../OpenGL/vertex array.hpp"
@@ -37,13 +40,48 @@ namespace G2D {
     /// had to be resized. If the GPU buffer had to be resized, it's contents
     /// will be cleared but only the given quads will be copied.
     bool writeQuads(QuadRange, const Quad *);
-    /// Render the quads in GPU memory with the given rendering parameters
+    /// Render the quads in GPU memory with the given rendering parameters.
+    /// Ranges of more than 16384 quads are split into several draw calls
     void render(QuadRange, const RenderParams &);
+    
+    /// Allocate GPU memory for streaming quads. The memory is a ring of
+    /// regions that each hold the given number of quads. Quads are written
+    /// straight into a region while the GPU reads from the other regions.
+    /// The ring is persistently mapped if glBufferStorage is available.
+    /// Otherwise a single region is orphaned each time it's written to.
+    void initStreaming(size_t);
+    /// Check whether streaming has been initialized
+    bool streaming() const;
+    /// Get GPU memory for writing the given number of quads. The number of
+    /// quads must not be zero. This waits for the GPU to finish reading the
+    /// next region of the ring. The ring grows if there isn't enough room in
+    /// a region
+    Quad *streamQuads(size_t);
+    /// Finish writing the streamed quads and get the range that they occupy.
+    /// The range can be rendered until the next call to streamQuads
+    QuadRange flushStream();
+    /// Render streamed quads with the given rendering parameters
+    void renderStream(QuadRange, const RenderParams &);
+    
+    /// Copy quad instances from CPU memory to GPU memory. Returns true if the
+    /// GPU memory had to be resized. Instances are stored separately from
+    /// quads
+    bool writeInstances(QuadRange, const QuadInstance *);
+    /// Render the quad instances in GPU memory with the given rendering
+    /// parameters. Each instance is drawn as a triangle strip without an
+    /// element buffer
+    void renderInstances(QuadRange, const RenderParams &);
   
   private:
+    static constexpr size_t STREAM_REGIONS = 3;
+    // every vertex of a draw call has to be reachable with an ElemType
+    static constexpr size_t MAX_DRAW_QUADS = (size_t{std::numeric_limits<ElemType>::max()} + 1) / QUAD_VERTS;
+  
+
     std::vector<GL::Texture2D> textures;
     std::vector<ElemType> indicies;
     size_t numQuads = 0;
+    size_t numElemQuads = 0;
     GL::ArrayBuffer arrayBuf;
     GL::ElementBuffer elemBuf;
     GL::VertexArray vertArray;
@@ -51,11 +89,32 @@ namespace G2D {
     GLint viewProjLoc;
     GLint texLoc;
     
+    size_t numInstances = 0;
+    GL::ArrayBuffer instBuf;
+    GL::VertexArray instArray;
+    GL::ShaderProgram instProgram;
+    GLint instViewProjLoc;
+    
+    GL::ArrayBuffer streamBuf;
+    GL::VertexArray streamArray;
+    std::array<GL::Fence, STREAM_REGIONS> streamFences;
+    #ifdef EMSCRIPTEN
+    // WebGL can't map buffers
+    std::vector<Quad> streamStaging;
+    #endif
+    Quad *streamMap = nullptr;
+    size_t regionQuads = 0;
+    size_t region = 0;
+    size_t streamCount = 0;
+    bool persistent = false;
+    
     void initState();
     void initUniforms();
     void initVertexArray();
     void fillIndicies(size_t);
+    void setElemBufSize(size_t);
     void setQuadBufSize(size_t);
+    void renderImpl(const GL::VertexArray &, const GL::ArrayBuffer &, QuadRange, const RenderParams &);
     template <size_t SIZE>
     void initImpl(const char (&)[SIZE]);
   };
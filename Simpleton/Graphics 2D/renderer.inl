@@ -6,6 +6,7 @@
 //  Copyright © 2018 Indi Kernick. All rights reserved.
 //
 
+#include <algorithm>
 #include "shaders.hpp"
 
 #include "load surface.hpp"
@@ -21,6 +22,19 @@ inline void G2D::Renderer::init() {
 }
 
 inline void G2D::Renderer::quit() {
+  for (GL::Fence &fence : streamFences) {
+    fence.reset();
+  }
+  streamArray.reset();
+  streamBuf.reset();
+  streamMap = nullptr;
+  regionQuads = 0;
+  numQuads = 0;
+  numElemQuads = 0;
+  instArray.reset();
+  instBuf.reset();
+  instProgram.reset();
+  numInstances = 0;
   elemBuf.reset();
   arrayBuf.reset();
   vertArray.reset();
@@ -94,7 +108,200 @@ inline bool G2D::Renderer::writeQuads(const QuadRange range, const Quad *quads)
 }
 
 inline void G2D::Renderer::render(const QuadRange range, const RenderParams &params) {
-  vertArray.bind();
+  renderImpl(vertArray, arrayBuf, range, params);
+}
+
+inline void G2D::Renderer::initStreaming(const size_t quads) {
+  assert(quads > 0);
+  
+  #ifdef EMSCRIPTEN
+  persistent = false;
+  #else
+  persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+  #endif
+  regionQuads = quads;
+  region = 0;
+  streamCount = 0;
+  for (GL::Fence &fence : streamFences) {
+    fence.reset();
+  }
+  
+  const size_t bufQuads = persistent ? STREAM_REGIONS * quads : quads;
+  const GLsizeiptr bufSize = static_cast<GLsizeiptr>(bufQuads * QUAD_ATTR_SIZE);
+  setElemBufSize(bufQuads);
+  
+  streamArray = GL::makeVertexArray();
+  streamArray.bind();
+  streamBuf = GL::makeArrayBuffer();
+  streamBuf.bind();
+  
+  #ifndef EMSCRIPTEN
+  if (persistent) {
+    // coherent so that writes are visible to the GPU without flushing
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, bufSize, nullptr, flags);
+    CHECK_OPENGL_ERROR();
+    streamMap = static_cast<Quad *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bufSize, flags));
+    CHECK_OPENGL_ERROR();
+  }
+  #endif
+  if (!persistent) {
+    glBufferData(GL_ARRAY_BUFFER, bufSize, nullptr, GL_STREAM_DRAW);
+    CHECK_OPENGL_ERROR();
+  }
+  
+  // packed texture coordinates and colors are normalized. Floats are not
+  // affected
+  GL::attribs<Attribs, GL::AttribMode::FIXED_POINT>();
+  elemBuf.bind();
+  
+  GL::unbindVertexArray();
+  GL::unbindArrayBuffer();
+}
+
+inline bool G2D::Renderer::streaming() const {
+  return static_cast<bool>(streamBuf);
+}
+
+inline G2D::Quad *G2D::Renderer::streamQuads(const size_t count) {
+  assert(streaming());
+  // mapping an empty range is an error
+  assert(count > 0);
+  if (count > regionQuads) {
+    initStreaming(count);
+  }
+  streamCount = count;
+  
+  if (persistent) {
+    // every draw that reads the current region has been issued so the fence
+    // is passed once the GPU is done with the region
+    streamFences[region] = GL::makeFence();
+    region = (region + 1) % STREAM_REGIONS;
+    streamFences[region].wait();
+    streamFences[region].reset();
+    return streamMap + region * regionQuads;
+  }
+  
+  #ifdef EMSCRIPTEN
+  streamStaging.resize(count);
+  return streamStaging.data();
+  #else
+  // orphaning gives the buffer new storage so the draws that are reading the
+  // old storage don't have to finish first
+  streamBuf.bind();
+  glBufferData(GL_ARRAY_BUFFER, regionQuads * QUAD_ATTR_SIZE, nullptr, GL_STREAM_DRAW);
+  CHECK_OPENGL_ERROR();
+  void *const map = glMapBufferRange(
+    GL_ARRAY_BUFFER,
+    0,
+    count * QUAD_ATTR_SIZE,
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+  );
+  CHECK_OPENGL_ERROR();
+  GL::unbindArrayBuffer();
+  return static_cast<Quad *>(map);
+  #endif
+}
+
+inline G2D::QuadRange G2D::Renderer::flushStream() {
+  assert(streaming());
+  if (persistent) {
+    const size_t begin = region * regionQuads;
+    return {begin, begin + streamCount};
+  }
+  
+  streamBuf.bind();
+  #ifdef EMSCRIPTEN
+  glBufferData(GL_ARRAY_BUFFER, regionQuads * QUAD_ATTR_SIZE, nullptr, GL_STREAM_DRAW);
+  CHECK_OPENGL_ERROR();
+  glBufferSubData(GL_ARRAY_BUFFER, 0, streamCount * QUAD_ATTR_SIZE, streamStaging.data());
+  CHECK_OPENGL_ERROR();
+  #else
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  CHECK_OPENGL_ERROR();
+  #endif
+  GL::unbindArrayBuffer();
+  return {0, streamCount};
+}
+
+inline void G2D::Renderer::renderStream(const QuadRange range, const RenderParams &params) {
+  assert(streaming());
+  renderImpl(streamArray, streamBuf, range, params);
+}
+
+namespace G2D::detail {
+  using InstAttribs = List::Type<
+    GL::Attrib<glm::vec2>,
+    GL::Attrib<glm::vec2>,
+    GL::Attrib<glm::vec2>,
+    GL::Attrib<glm::vec2>,
+    GL::Attrib<float>,
+    GL::Attrib<float>,
+    GL::Attrib<glm::tvec4<uint8_t>, GL::AttribMode::FIXED_POINT>
+  >;
+  constexpr GLuint INST_ATTRIBS = 7;
+  
+  static_assert(sizeof(QuadInstance) == 44);
+}
+
+inline bool G2D::Renderer::writeInstances(
+  const QuadRange range,
+  const QuadInstance *instances
+) {
+  instBuf.bind();
+  const bool resized = range.end > numInstances;
+  if (resized) {
+    numInstances = range.end;
+    glBufferData(GL_ARRAY_BUFFER, numInstances * sizeof(QuadInstance), nullptr, GL_DYNAMIC_DRAW);
+    CHECK_OPENGL_ERROR();
+  }
+  if (instances != nullptr) {
+    glBufferSubData(
+      GL_ARRAY_BUFFER,
+      sizeof(QuadInstance) * range.begin,
+      sizeof(QuadInstance) * range.size(),
+      instances
+    );
+    CHECK_OPENGL_ERROR();
+  }
+  GL::unbindArrayBuffer();
+  
+  return resized;
+}
+
+inline void G2D::Renderer::renderInstances(
+  const QuadRange range,
+  const RenderParams &params
+) {
+  instArray.bind();
+  instProgram.use();
+  
+  // there's no base instance in GL 3.3 or ES 3.0 so the attributes are
+  // pointed at the first instance instead
+  instBuf.bind();
+  GL::attribsMode<detail::InstAttribs>(sizeof(QuadInstance) * range.begin);
+  GL::unbindArrayBuffer();
+  
+  GL::setUniform(instViewProjLoc, params.viewProj);
+  textures.at(params.tex).bind(0);
+  
+  instProgram.validateAndLog();
+  
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(range.size()));
+  CHECK_OPENGL_ERROR();
+  
+  GL::unbindTexture2D(0);
+  GL::unuseProgram();
+  GL::unbindVertexArray();
+}
+
+inline void G2D::Renderer::renderImpl(
+  const GL::VertexArray &array,
+  [[maybe_unused]] const GL::ArrayBuffer &buffer,
+  const QuadRange range,
+  const RenderParams &params
+) {
+  array.bind();
   program.use();
   
   GL::setUniform(viewProjLoc, params.viewProj);
@@ -102,13 +309,33 @@ inline void G2D::Renderer::render(const QuadRange range, const RenderParams &par
   
   program.validateAndLog();
   
-  glDrawElements(
-    GL_TRIANGLES,
-    static_cast<GLsizei>(QUAD_INDICIES * range.size()),
-    GL::TypeEnum<ElemType>::type,
-    reinterpret_cast<GLvoid *>(QUAD_ELEM_SIZE * range.begin)
-  );
-  CHECK_OPENGL_ERROR();
+  // the element buffer only covers MAX_DRAW_QUADS so every draw starts at
+  // the beginning of it and the vertices are offset instead
+  for (size_t begin = range.begin; begin < range.end; begin += MAX_DRAW_QUADS) {
+    const size_t quads = std::min(range.end - begin, MAX_DRAW_QUADS);
+    #ifdef EMSCRIPTEN
+    // there's no base vertex in ES 3.0 so the attributes are pointed at the
+    // first quad instead
+    buffer.bind();
+    GL::attribs<Attribs, GL::AttribMode::FIXED_POINT>(QUAD_ATTR_SIZE * begin);
+    GL::unbindArrayBuffer();
+    glDrawElements(
+      GL_TRIANGLES,
+      static_cast<GLsizei>(QUAD_INDICIES * quads),
+      GL::TypeEnum<ElemType>::type,
+      nullptr
+    );
+    #else
+    glDrawElementsBaseVertex(
+      GL_TRIANGLES,
+      static_cast<GLsizei>(QUAD_INDICIES * quads),
+      GL::TypeEnum<ElemType>::type,
+      nullptr,
+      static_cast<GLint>(QUAD_VERTS * begin)
+    );
+    #endif
+    CHECK_OPENGL_ERROR();
+  }
   
   GL::unbindTexture2D(0);
   GL::unuseProgram();
@@ -129,6 +356,12 @@ inline void G2D::Renderer::initUniforms() {
   program.use();
   GL::setUniform(texLoc, 0);
   GL::unuseProgram();
+  
+  instViewProjLoc = instProgram.getUniformLoc("viewProj");
+  
+  instProgram.use();
+  GL::setUniform(instProgram.getUniformLoc("tex"), 0);
+  GL::unuseProgram();
 }
 
 inline void G2D::Renderer::initVertexArray() {
@@ -138,17 +371,34 @@ inline void G2D::Renderer::initVertexArray() {
   arrayBuf = GL::makeArrayBuffer(size_t(0), GL_DYNAMIC_DRAW);
   elemBuf = GL::makeElementBuffer(size_t(0), GL_STATIC_DRAW);
   
-  GL::attribs<Attribs>();
+  // packed texture coordinates and colors are normalized. Floats are not
+  // affected
+  GL::attribs<Attribs, GL::AttribMode::FIXED_POINT>();
   
   GL::unbindVertexArray();
+  
+  instArray = GL::makeVertexArray();
+  instArray.bind();
+  
+  instBuf = GL::makeArrayBuffer(size_t(0), GL_DYNAMIC_DRAW);
+  GL::attribsMode<detail::InstAttribs>();
+  for (GLuint a = 0; a != detail::INST_ATTRIBS; ++a) {
+    glVertexAttribDivisor(a, 1);
+    CHECK_OPENGL_ERROR();
+  }
+  
+  GL::unbindVertexArray();
+  GL::unbindArrayBuffer();
 }
 
 inline void G2D::Renderer::fillIndicies(const size_t minQuads) {
-  if (indicies.size() < minQuads * QUAD_INDICIES) {
+  // the last index of a larger buffer wouldn't fit in an ElemType
+  assert(minQuads <= MAX_DRAW_QUADS);
+  const size_t oldQuads = indicies.size() / QUAD_INDICIES;
+  if (oldQuads < minQuads) {
     indicies.reserve(minQuads * QUAD_INDICIES);
-    ElemType index = indicies.size() / QUAD_INDICIES * QUAD_VERTS;
-    const ElemType lastIndex = minQuads * QUAD_VERTS;
-    for (; index != lastIndex; index += QUAD_VERTS) {
+    for (size_t q = oldQuads; q != minQuads; ++q) {
+      const ElemType index = static_cast<ElemType>(q * QUAD_VERTS);
       indicies.push_back(index + 0);
       indicies.push_back(index + 1);
       indicies.push_back(index + 2);
@@ -159,19 +409,32 @@ inline void G2D::Renderer::fillIndicies(const size_t minQuads) {
   }
 }
 
+inline void G2D::Renderer::setElemBufSize(const size_t quads) {
+  // the element buffer is shared by the quad buffer and the stream buffer.
+  // Larger ranges are drawn in pieces
+  const size_t elemQuads = std::min(quads, MAX_DRAW_QUADS);
+  if (elemQuads <= numElemQuads) {
+    return;
+  }
+  numElemQuads = elemQuads;
+  fillIndicies(numElemQuads);
+  assert(indicies.size() >= numElemQuads * QUAD_INDICIES);
+  
+  elemBuf.bind();
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, numElemQuads * QUAD_ELEM_SIZE, indicies.data(), GL_STATIC_DRAW);
+  CHECK_OPENGL_ERROR();
+  GL::unbindElementBuffer();
+}
+
 inline void G2D::Renderer::setQuadBufSize(const size_t quads) {
   numQuads = quads;
-  fillIndicies(numQuads);
   
   arrayBuf.bind();
   glBufferData(GL_ARRAY_BUFFER, numQuads * QUAD_ATTR_SIZE, nullptr, GL_DYNAMIC_DRAW);
   CHECK_OPENGL_ERROR();
   GL::unbindArrayBuffer();
   
-  elemBuf.bind();
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, numQuads * QUAD_ELEM_SIZE, indicies.data(), GL_STATIC_DRAW);
-  CHECK_OPENGL_ERROR();
-  GL::unbindElementBuffer();
+  setElemBufSize(numQuads);
 }
 
 template <size_t SIZE>
@@ -181,6 +444,10 @@ inline void G2D::Renderer::initImpl(const char (&version)[SIZE]) {
     GL::makeVertShader(version, VERT_SHADER),
     GL::makeFragShader(version, FRAG_SHADER)
   );
+  instProgram = GL::makeShaderProgram(
+    GL::makeVertShader(version, INST_VERT_SHADER),
+    GL::makeFragShader(version, FRAG_SHADER)
+  );
   initUniforms();
   initVertexArray();
 }
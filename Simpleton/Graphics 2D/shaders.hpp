@@ -29,6 +29,35 @@ void main() {
   fragTexCoord = texCoord;
   fragColor = color;
 }
+)delimiter";
+
+  const char INST_VERT_SHADER[] = R"delimiter(
+layout (location = 0) in vec2 pos;
+layout (location = 1) in vec2 size;
+layout (location = 2) in vec2 texMin;
+layout (location = 3) in vec2 texMax;
+layout (location = 4) in float angle;
+layout (location = 5) in float depth;
+layout (location = 6) in vec4 color;
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+uniform mat3 viewProj;
+
+void main() {
+  // corners of a triangle strip
+  vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+  vec2 local = (corner - 0.5) * size;
+  float c = cos(angle);
+  float s = sin(angle);
+  vec2 rotated = vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+  vec2 world = pos + size * 0.5 + rotated;
+  gl_Position.xy = (viewProj * vec3(world, 1.0)).xy;
+  gl_Position.zw = vec2(depth, 1.0);
+  fragTexCoord = mix(texMin, texMax, corner);
+  fragColor = color;
+}
 )delimiter";
 
   const char FRAG_SHADER[] = R"delimiter(
@@ -20,6 +20,23 @@ namespace G2D {
   bool sortDeep(const Quad &, const Quad &);
   /// Sort by the depth of the shallowest vertex
   bool sortShallow(const Quad &, const Quad &);
+  
+  /// The depth of the first vertex
+  float sortKey(const Quad &);
+  /// The average depth of the verticies
+  float sortCenterKey(const Quad &);
+  /// The depth of the deepest vertex
+  float sortDeepKey(const Quad &);
+  /// The depth of the shallowest vertex
+  float sortShallowKey(const Quad &);
+  
+  /// Sort quads from deepest to shallowest by the depth returned from one of
+  /// the key functions. The depths are radix sorted along with the index of
+  /// each quad and then the quads are moved into place. This is a lot faster
+  /// than std::sort for lots of quads. Quads with the same depth stay in the
+  /// same order
+  template <typename Function>
+  void depthSort(Quad *, Quad *, Function &&);
 }
 
 #include "zsort.inl"
@@ -6,6 +6,11 @@
 //  Copyright © 2018 Indi Kernick. All rights reserved.
 //
 
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
 inline bool G2D::sort(const Quad &a, const Quad &b) {
   return a[0].pos.z > b[0].pos.z;
 }
@@ -27,3 +32,94 @@ inline bool G2D::sortShallow(const Quad &a, const Quad &b) {
   const auto bDepth = std::min({b[0].pos.z, b[1].pos.z, b[2].pos.z, b[3].pos.z});
   return aDepth > bDepth;
 }
+
+inline float G2D::sortKey(const Quad &quad) {
+  return quad[0].pos.z;
+}
+
+inline float G2D::sortCenterKey(const Quad &quad) {
+  // the comparator doesn't divide so neither does this
+  return quad[0].pos.z + quad[1].pos.z + quad[2].pos.z + quad[3].pos.z;
+}
+
+inline float G2D::sortDeepKey(const Quad &quad) {
+  return std::max({quad[0].pos.z, quad[1].pos.z, quad[2].pos.z, quad[3].pos.z});
+}
+
+inline float G2D::sortShallowKey(const Quad &quad) {
+  return std::min({quad[0].pos.z, quad[1].pos.z, quad[2].pos.z, quad[3].pos.z});
+}
+
+namespace G2D::detail {
+  struct DepthIndex {
+    uint32_t key;
+    uint32_t index;
+  };
+
+  // the bits of a float can be sorted as an integer if the sign bit is
+  // flipped for positive floats and every bit is flipped for negative floats.
+  // The result is inverted so that the deepest quad comes first
+  inline uint32_t depthKey(const float depth) {
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(float));
+    const uint32_t mask = (bits >> 31) ? 0xFFFFFFFF : 0x80000000;
+    return ~(bits ^ mask);
+  }
+}
+
+template <typename Function>
+void G2D::depthSort(Quad *const begin, Quad *const end, Function &&key) {
+  assert(begin <= end);
+  const size_t size = static_cast<size_t>(end - begin);
+  assert(size <= 0xFFFFFFFF);
+  if (size < 2) {
+    return;
+  }
+  
+  std::vector<detail::DepthIndex> pairs(size);
+  std::vector<detail::DepthIndex> temp(size);
+  uint32_t counts[4][256] = {};
+  for (size_t i = 0; i != size; ++i) {
+    const uint32_t depthKey = detail::depthKey(key(begin[i]));
+    pairs[i] = {depthKey, static_cast<uint32_t>(i)};
+    ++counts[0][depthKey & 255];
+    ++counts[1][(depthKey >> 8) & 255];
+    ++counts[2][(depthKey >> 16) & 255];
+    ++counts[3][depthKey >> 24];
+  }
+  
+  for (unsigned pass = 0; pass != 4; ++pass) {
+    const unsigned shift = pass * 8;
+    uint32_t *const count = counts[pass];
+    // depths are usually close together so a lot of passes can be skipped
+    if (count[(pairs[0].key >> shift) & 255] == size) {
+      continue;
+    }
+    uint32_t offset = 0;
+    for (unsigned digit = 0; digit != 256; ++digit) {
+      offset += std::exchange(count[digit], offset);
+    }
+    for (const detail::DepthIndex pair : pairs) {
+      temp[count[(pair.key >> shift) & 255]++] = pair;
+    }
+    pairs.swap(temp);
+  }
+  
+  // follow each cycle of the permutation so that each quad is only moved once
+  for (uint32_t i = 0; i != size; ++i) {
+    if (pairs[i].index == i) {
+      continue;
+    }
+    const Quad first = begin[i];
+    uint32_t dst = i;
+    uint32_t src = pairs[i].index;
+    while (src != i) {
+      begin[dst] = begin[src];
+      pairs[dst].index = dst;
+      dst = src;
+      src = pairs[dst].index;
+    }
+    begin[dst] = first;
+    pairs[dst].index = dst;
+  }
+}
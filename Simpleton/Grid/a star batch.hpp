@@ -0,0 +1,90 @@
+//
+//  a star batch.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_a_star_batch_hpp
+#define engine_grid_a_star_batch_hpp
+
+#include "a star.hpp"
+#include "../Utils/worker pool.hpp"
+
+namespace Grid {
+  /// A start and an end
+  using PathQuery = std::pair<Pos, Pos>;
+
+  /// A pool of worker threads that each have their own AStarWorkspace. This
+  /// should be kept around and reused for every batch so that threads and
+  /// search buffers aren't created every time.
+  class AStarBatch {
+  public:
+    /// Create a batch with a number of workers (including the calling
+    /// thread). 0 means one worker per core
+    explicit AStarBatch(const unsigned workers = 0)
+      : pool{workers}, workspaces(pool.size()) {}
+
+    /// Number of workers including the calling thread
+    unsigned size() const {
+      return pool.size();
+    }
+    Utils::WorkerPool &workers() {
+      return pool;
+    }
+    AStarWorkspace &workspace(const unsigned worker) {
+      return workspaces[worker];
+    }
+
+  private:
+    Utils::WorkerPool pool;
+    std::vector<AStarWorkspace> workspaces;
+  };
+
+  /// Solve many A* queries at the same time. The path for each query is
+  /// written to the same index of the output vector. notPath is called from
+  /// multiple threads at the same time so it must not modify anything.
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function
+  >
+  void astarBatch(
+    AStarBatch &,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    const std::vector<PathQuery> &,
+    std::vector<std::vector<Pos>> &
+  );
+
+  /// Solve many A* queries at the same time with a cost function. The cost
+  /// function is called from multiple threads at the same time.
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function, typename CostFunction
+  >
+  void astarBatch(
+    AStarBatch &,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    CostFunction &&,
+    const std::vector<PathQuery> &,
+    std::vector<std::vector<Pos>> &
+  );
+
+  /// Solve many A* queries at the same time on a bit grid. Set bits are not
+  /// path.
+  template <typename Movement = FourWay, typename Heuristic = typename Movement::Heuristic>
+  void astarBatch(
+    AStarBatch &,
+    const BitGrid &,
+    const std::vector<PathQuery> &,
+    std::vector<std::vector<Pos>> &
+  );
+}
+
+#include "a star batch.inl"
+
+#endif
@@ -0,0 +1,79 @@
+//
+//  a star batch.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+namespace Grid::detail {
+  template <typename Movement, typename Heuristic, typename GridType, typename Function, typename CostFunction>
+  void astarBatch(
+    AStarBatch &batch,
+    const GridType &grid,
+    Function &notPath,
+    CostFunction &tileCost,
+    const std::vector<PathQuery> &queries,
+    std::vector<std::vector<Pos>> &paths
+  ) {
+    paths.resize(queries.size());
+    // queries take different amounts of time so workers take one at a time
+    batch.workers().run(queries.size(), [&] (const size_t q, const unsigned worker) {
+      paths[q] = detail::astar<Movement, Heuristic>(
+        batch.workspace(worker),
+        grid,
+        notPath,
+        tileCost,
+        queries[q].first,
+        queries[q].second
+      );
+    });
+  }
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function
+>
+void Grid::astarBatch(
+  AStarBatch &batch,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const std::vector<PathQuery> &queries,
+  std::vector<std::vector<Pos>> &paths
+) {
+  UnitCost tileCost;
+  detail::astarBatch<Movement, Heuristic>(batch, grid, notPath, tileCost, queries, paths);
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function, typename CostFunction
+>
+void Grid::astarBatch(
+  AStarBatch &batch,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  CostFunction &&tileCost,
+  const std::vector<PathQuery> &queries,
+  std::vector<std::vector<Pos>> &paths
+) {
+  detail::astarBatch<Movement, Heuristic>(batch, grid, notPath, tileCost, queries, paths);
+}
+
+template <typename Movement, typename Heuristic>
+void Grid::astarBatch(
+  AStarBatch &batch,
+  const BitGrid &grid,
+  const std::vector<PathQuery> &queries,
+  std::vector<std::vector<Pos>> &paths
+) {
+  // set bits are not path
+  auto notPath = [] (const bool bit) {
+    return bit;
+  };
+  UnitCost tileCost;
+  detail::astarBatch<Movement, Heuristic>(batch, grid, notPath, tileCost, queries, paths);
+}
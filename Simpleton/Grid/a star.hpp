@@ -10,12 +10,206 @@
 #define engine_grid_a_star_hpp
 
 #include "grid.hpp"
+#include "bit grid.hpp"
+#include "distance.hpp"
 
 namespace Grid {
+  /// Heuristic that estimates the cost of moving horizontally and vertically
+  /// to the target. Admissible for FourWay
+  struct Manhattan {
+    template <typename Movement>
+    static Coord dist(const Pos a, const Pos b) {
+      return Movement::straight * sumAxis(a, b);
+    }
+  };
+
+  /// Heuristic that estimates the cost of moving diagonally as far as possible
+  /// and then straight to the target. Admissible for all movement policies
+  struct Octile {
+    template <typename Movement>
+    static Coord dist(const Pos a, const Pos b) {
+      const Coord hori = horiDist(a, b);
+      const Coord vert = vertDist(a, b);
+      const Coord diag = std::min(hori, vert);
+      return Movement::straight * (hori + vert - 2 * diag) + Movement::diagonal * diag;
+    }
+  };
+
+  /// Heuristic that estimates the straight line cost to the target. This is
+  /// slower to compute than Manhattan and Octile. It isn't quite admissible
+  /// for EightWay because diagonal moves are rounded down to 14
+  struct Euclid {
+    template <typename Movement>
+    static Coord dist(const Pos a, const Pos b) {
+      return static_cast<Coord>(Movement::straight * euclid(a, b));
+    }
+  };
+
+  /// A heuristic that is always zero. This turns A* into Dijkstra's algorithm
+  struct NoHeuristic {
+    template <typename Movement>
+    static Coord dist(Pos, Pos) {
+      return 0;
+    }
+  };
+
+  /// Movement policy that allows moving up, right, down and left
+  struct FourWay {
+    using Heuristic = Manhattan;
+    static constexpr bool diagonals = false;
+    static constexpr bool cut_corners = false;
+    static constexpr Coord straight = 1;
+    // a diagonal step is two straight steps
+    static constexpr Coord diagonal = 2;
+  };
+
+  /// Movement policy that allows moving diagonally. A diagonal move can cut
+  /// the corner of a tile that is not a path tile. Costs are scaled by 10 so
+  /// that the cost of a diagonal move is close to the square root of 2
+  struct EightWay {
+    using Heuristic = Octile;
+    static constexpr bool diagonals = true;
+    static constexpr bool cut_corners = true;
+    static constexpr Coord straight = 10;
+    static constexpr Coord diagonal = 14;
+  };
+
+  /// Movement policy that allows moving diagonally only if both of the tiles
+  /// next to the diagonal are path tiles
+  struct EightWayNoCorners {
+    using Heuristic = Octile;
+    static constexpr bool diagonals = true;
+    static constexpr bool cut_corners = false;
+    static constexpr Coord straight = 10;
+    static constexpr Coord diagonal = 14;
+  };
+
+  /// Cost function that gives every tile the same cost
+  struct UnitCost {
+    template <typename Tile>
+    constexpr Coord operator()(const Tile &) const {
+      return 1;
+    }
+  };
+
+  /// Buffers used by A* that can be reused between queries. The per-tile
+  /// arrays are indexed by Grid::toIndex and stamped with a generation so they
+  /// never have to be cleared. Reusing a workspace means that repeated queries
+  /// don't allocate.
+  class AStarWorkspace {
+  public:
+    using Index = uint32_t;
+    static constexpr Index none = ~Index{};
+
+    AStarWorkspace() = default;
+    /// Make space for a grid with the given number of tiles
+    explicit AStarWorkspace(size_t);
+
+    /// Make space for a grid with the given number of tiles
+    void reserve(size_t);
+    /// Prepare for a new query on a grid with the given number of tiles. This
+    /// is constant time unless the workspace needs to grow
+    void reset(size_t);
+
+    /// Has a path to the tile been found during the current query?
+    bool reached(Index) const;
+    /// Has the tile been removed from the queue during the current query?
+    bool closed(Index) const;
+    /// Get the cost of the best known path to a reached tile
+    Coord cost(Index) const;
+    /// Get the previous tile on the best known path to a reached tile. This is
+    /// none for the first tile
+    Index parent(Index) const;
+
+    /// Record a path to a tile if it is shorter than the best known path. The
+    /// tile is pushed onto the queue (or moved up the queue) with the given
+    /// priority. Returns false if the path isn't shorter
+    bool relax(Index, Index, Coord, Coord);
+    /// Is the queue empty?
+    bool empty() const;
+    /// Remove the tile with the smallest priority from the queue and close it
+    Index pop();
+    /// Number of tiles removed from the queue during the current query
+    size_t expanded() const;
+
+  private:
+    struct Node {
+      uint32_t generation;
+      Index parent;
+      Coord cost;
+      Index heapPos; // position in the heap or none if closed
+    };
+    struct Entry {
+      Coord priority;
+      Index index;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Entry> heap;
+    uint32_t generation = 0;
+    size_t numExpanded = 0;
+
+    void place(size_t, Entry);
+    void siftUp(size_t);
+    void siftDown(size_t);
+  };
+
+  /// The A* search algorithm. Returns the shortest path or an empty vector if
+  /// there is no path. The movement policy is one of FourWay, EightWay or
+  /// EightWayNoCorners. The heuristic is one of Manhattan, Octile, Euclid or
+  /// NoHeuristic and defaults to the one that suits the movement policy.
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function
+  >
+  std::vector<Pos> astar(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Pos);
+
   /// The A* search algorithm. Returns the shortest path or an empty vector if
-  /// there is no path.
-  template <typename Tile, Coord Width, Coord Height, typename Function>
-  std::vector<Pos> astar(const Grid<Tile, Width, Height> &, Function &&, Pos, Pos);
+  /// there is no path. The workspace should be reused for repeated queries.
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function
+  >
+  std::vector<Pos> astar(AStarWorkspace &, const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Pos);
+
+  /// The A* search algorithm with a cost function. The cost function returns
+  /// the integer cost of moving onto a tile. The cost is multiplied by the
+  /// cost of the move. Costs must be at least 1 for the heuristics to be
+  /// admissible
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function, typename CostFunction
+  >
+  std::vector<Pos> astar(const Grid<Tile, Width, Height, Layout> &, Function &&, CostFunction &&, Pos, Pos);
+
+  /// The A* search algorithm with a cost function. The workspace should be
+  /// reused for repeated queries.
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function, typename CostFunction
+  >
+  std::vector<Pos> astar(AStarWorkspace &, const Grid<Tile, Width, Height, Layout> &, Function &&, CostFunction &&, Pos, Pos);
+
+  /// The A* search algorithm on a bit grid. Set bits are not path. This saves
+  /// writing a predicate and uses less memory than a Grid<bool> but the
+  /// search still reads one bit per neighbor so it is no faster than astar
+  /// on a Grid. Only onePath skips through a BitGrid a word at a time
+  template <typename Movement = FourWay, typename Heuristic = typename Movement::Heuristic>
+  std::vector<Pos> astar(const BitGrid &, Pos, Pos);
+
+  /// The A* search algorithm on a bit grid. Set bits are not path. The
+  /// workspace should be reused for repeated queries.
+  template <typename Movement = FourWay, typename Heuristic = typename Movement::Heuristic>
+  std::vector<Pos> astar(AStarWorkspace &, const BitGrid &, Pos, Pos);
+
+  namespace detail {
+    template <typename Movement, typename Heuristic, typename GridType, typename Function, typename CostFunction>
+    std::vector<Pos> astar(AStarWorkspace &, const GridType &, Function &, CostFunction &, Pos, Pos);
+  }
 }
 
 #include "a star.inl"
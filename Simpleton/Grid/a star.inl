@@ -9,10 +9,188 @@
 #include "dir.hpp"
 #include "distance.hpp"
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Function>
+inline Grid::AStarWorkspace::AStarWorkspace(const size_t area) {
+  reserve(area);
+}
+
+inline void Grid::AStarWorkspace::reserve(const size_t area) {
+  assert(area < none);
+  if (nodes.size() < area) {
+    // generation 0 is never current so new nodes are unreached
+    nodes.resize(area, Node{0, none, 0, none});
+  }
+  heap.reserve(area);
+}
+
+inline void Grid::AStarWorkspace::reset(const size_t area) {
+  reserve(area);
+  heap.clear();
+  numExpanded = 0;
+  if (++generation == 0) {
+    // the generation wrapped around so the stamps need to be cleared
+    for (Node &node : nodes) {
+      node.generation = 0;
+    }
+    generation = 1;
+  }
+}
+
+inline bool Grid::AStarWorkspace::reached(const Index index) const {
+  assert(index < nodes.size());
+  return nodes[index].generation == generation;
+}
+
+inline bool Grid::AStarWorkspace::closed(const Index index) const {
+  return reached(index) && nodes[index].heapPos == none;
+}
+
+inline Grid::Coord Grid::AStarWorkspace::cost(const Index index) const {
+  assert(reached(index));
+  return nodes[index].cost;
+}
+
+inline Grid::AStarWorkspace::Index Grid::AStarWorkspace::parent(const Index index) const {
+  assert(reached(index));
+  return nodes[index].parent;
+}
+
+inline bool Grid::AStarWorkspace::relax(
+  const Index index,
+  const Index parent,
+  const Coord cost,
+  const Coord priority
+) {
+  Node &node = nodes[index];
+  if (node.generation != generation) {
+    node.generation = generation;
+    node.parent = parent;
+    node.cost = cost;
+    heap.push_back({priority, index});
+    siftUp(heap.size() - 1);
+    return true;
+  } else if (node.heapPos == none || cost >= node.cost) {
+    return false;
+  }
+
+  node.parent = parent;
+  node.cost = cost;
+  heap[node.heapPos].priority = priority;
+  siftUp(node.heapPos);
+  return true;
+}
+
+inline bool Grid::AStarWorkspace::empty() const {
+  return heap.empty();
+}
+
+inline Grid::AStarWorkspace::Index Grid::AStarWorkspace::pop() {
+  assert(!heap.empty());
+  const Index top = heap.front().index;
+  nodes[top].heapPos = none;
+  ++numExpanded;
+  const Entry last = heap.back();
+  heap.pop_back();
+  if (!heap.empty()) {
+    place(0, last);
+    siftDown(0);
+  }
+  return top;
+}
+
+inline size_t Grid::AStarWorkspace::expanded() const {
+  return numExpanded;
+}
+
+inline void Grid::AStarWorkspace::place(const size_t pos, const Entry entry) {
+  heap[pos] = entry;
+  nodes[entry.index].heapPos = static_cast<Index>(pos);
+}
+
+inline void Grid::AStarWorkspace::siftUp(size_t pos) {
+  const Entry entry = heap[pos];
+  while (pos != 0) {
+    const size_t parentPos = (pos - 1) / 2;
+    if (heap[parentPos].priority <= entry.priority) {
+      break;
+    }
+    place(pos, heap[parentPos]);
+    pos = parentPos;
+  }
+  place(pos, entry);
+}
+
+inline void Grid::AStarWorkspace::siftDown(size_t pos) {
+  const Entry entry = heap[pos];
+  const size_t size = heap.size();
+  while (true) {
+    size_t childPos = pos * 2 + 1;
+    if (childPos >= size) {
+      break;
+    }
+    if (childPos + 1 < size && heap[childPos + 1].priority < heap[childPos].priority) {
+      ++childPos;
+    }
+    if (entry.priority <= heap[childPos].priority) {
+      break;
+    }
+    place(pos, heap[childPos]);
+    pos = childPos;
+  }
+  place(pos, entry);
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function
+>
+std::vector<Grid::Pos> Grid::astar(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const Pos start,
+  const Pos end
+) {
+  AStarWorkspace workspace;
+  return astar<Movement, Heuristic>(workspace, grid, notPath, UnitCost{}, start, end);
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function
+>
+std::vector<Grid::Pos> Grid::astar(
+  AStarWorkspace &workspace,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const Pos start,
+  const Pos end
+) {
+  return astar<Movement, Heuristic>(workspace, grid, notPath, UnitCost{}, start, end);
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function, typename CostFunction
+>
 std::vector<Grid::Pos> Grid::astar(
-  const Grid<Tile, Width, Height> &grid,
+  const Grid<Tile, Width, Height, Layout> &grid,
   Function &&notPath,
+  CostFunction &&tileCost,
+  const Pos start,
+  const Pos end
+) {
+  AStarWorkspace workspace;
+  return detail::astar<Movement, Heuristic>(workspace, grid, notPath, tileCost, start, end);
+}
+
+template <typename Movement, typename Heuristic, typename GridType, typename Function, typename CostFunction>
+std::vector<Grid::Pos> Grid::detail::astar(
+  AStarWorkspace &workspace,
+  const GridType &grid,
+  Function &notPath,
+  CostFunction &tileCost,
   const Pos start,
   const Pos end
 ) {
@@ -23,85 +201,113 @@ std::vector<Grid::Pos> Grid::astar(
   // this algorithm searchs from the end and finds the start
   // this is to avoid std::reversing the final path vector
 
-  struct Node {
-    Pos pos;
-    Pos prevPos;        // position of previous node
-    Coord pathCost;     // number of tiles from end
-    float combinedCost; // pathCost + distance to start
-  };
+  using Index = AStarWorkspace::Index;
+  const Index startIndex = static_cast<Index>(grid.toIndex(start));
+  const Index endIndex = static_cast<Index>(grid.toIndex(end));
   
-  // sort the priority queue by the combined cost
-  // small costs at the top
-  const auto comp = [] (const Node &a, const Node &b) {
-    return a.combinedCost > b.combinedCost;
-  };
-  std::vector<Node> queue;
-  std::vector<Node> popped;
+  workspace.reset(grid.area());
+  workspace.relax(
+    endIndex,
+    AStarWorkspace::none,
+    0,
+    Heuristic::template dist<Movement>(start, end)
+  );
   
-  queue.push_back({end, end, 0, euclid(start, end)});
+  // the first four are straight and the last four are diagonal
+  constexpr Pos offsets[8] = {
+    {0, 1}, {1, 0}, {0, -1}, {-1, 0},
+    {1, 1}, {1, -1}, {-1, -1}, {-1, 1}
+  };
+  constexpr size_t numOffsets = Movement::diagonals ? 8 : 4;
   
-  do {
-    if (queue.empty()) {
-      // there is no path
-      return {};
-    } else if (queue.front().pos == start) {
+  while (!workspace.empty()) {
+    // grab the top node
+    const Index topIndex = workspace.pop();
+    
+    if (topIndex == startIndex) {
       // the shortest path has been found
       std::vector<Pos> path;
-      path.push_back(start);
-      const Node *topNode = &queue.front();
-      
-      for (auto n = popped.rbegin(); n != popped.rend(); ++n) {
-        const Node &node = *n;
-        if (node.pos == topNode->prevPos) {
-          path.push_back(node.pos);
-          topNode = &node;
-        }
+      for (Index i = startIndex; i != AStarWorkspace::none; i = workspace.parent(i)) {
+        path.push_back(grid.toPos(i));
       }
       
       return path;
     }
     
-    // grab the top node
-    const Node topNode = queue.front();
-    std::pop_heap(queue.begin(), queue.end(), comp);
-    queue.pop_back();
-    popped.push_back(topNode);
-    const Coord neighPathCost = topNode.pathCost + 1;
+    const Pos topPos = grid.toPos(topIndex);
+    const Coord topCost = workspace.cost(topIndex);
+    // we're searching backwards so the neighbor moves onto the top node
+    const Coord moveCost = tileCost(grid[topIndex]);
+    assert(moveCost > 0);
     
     // look at all of the tiles around the top node
-    for (const Dir dir : dir_range) {
-      const Pos neighPos = topNode.pos + toVec<Coord>(dir);
-      if (neighPos == topNode.prevPos || grid.outOfRange(neighPos) || notPath(grid[neighPos])) {
+    for (size_t o = 0; o != numOffsets; ++o) {
+      const Pos offset = offsets[o];
+      const Pos neighPos = topPos + offset;
+      if (grid.outOfRange(neighPos)) {
         continue;
       }
-      const Node neighNode {
-        neighPos,
-        topNode.pos,
-        neighPathCost,
-        neighPathCost + euclid(neighPos, start)
-      };
-      
-      // check if the current neighbor is already in the queue
-      bool assigned = false;
-      for (auto n = queue.cbegin(); n != queue.cend(); ++n) {
-        const Node &node = *n;
-        if (node.pos == neighPos) {
-          assigned = true;
-          // if we've found a shorter path to the same node,
-          // replace the existing node with a new one
-          if (neighNode.pathCost < node.pathCost) {
-            queue.erase(n);
-            queue.push_back(node);
-            std::push_heap(queue.begin(), queue.end(), comp);
-          }
-          break;
-        }
+      const Index neighIndex = static_cast<Index>(grid.toIndex(neighPos));
+      if (workspace.closed(neighIndex) || notPath(grid[neighIndex])) {
+        continue;
       }
-      if (!assigned) {
-        // push if the node hasn't replaced an existing node
-        queue.push_back(neighNode);
-        std::push_heap(queue.begin(), queue.end(), comp);
+      if constexpr (Movement::diagonals && !Movement::cut_corners) {
+        if (o >= 4 && (
+          notPath(grid[Pos{neighPos.x, topPos.y}]) ||
+          notPath(grid[Pos{topPos.x, neighPos.y}])
+        )) {
+          continue;
+        }
       }
+      const Coord neighPathCost = topCost + moveCost * (
+        o < 4 ? Movement::straight : Movement::diagonal
+      );
+      workspace.relax(
+        neighIndex,
+        topIndex,
+        neighPathCost,
+        neighPathCost + Heuristic::template dist<Movement>(neighPos, start)
+      );
     }
-  } while (true);
+  }
+  
+  // there is no path
+  return {};
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function, typename CostFunction
+>
+std::vector<Grid::Pos> Grid::astar(
+  AStarWorkspace &workspace,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  CostFunction &&tileCost,
+  const Pos start,
+  const Pos end
+) {
+  return detail::astar<Movement, Heuristic>(workspace, grid, notPath, tileCost, start, end);
+}
+
+template <typename Movement, typename Heuristic>
+std::vector<Grid::Pos> Grid::astar(const BitGrid &grid, const Pos start, const Pos end) {
+  AStarWorkspace workspace;
+  return astar<Movement, Heuristic>(workspace, grid, start, end);
+}
+
+template <typename Movement, typename Heuristic>
+std::vector<Grid::Pos> Grid::astar(
+  AStarWorkspace &workspace,
+  const BitGrid &grid,
+  const Pos start,
+  const Pos end
+) {
+  // set bits are not path
+  auto notPath = [] (const bool bit) {
+    return bit;
+  };
+  UnitCost tileCost;
+  return detail::astar<Movement, Heuristic>(workspace, grid, notPath, tileCost, start, end);
 }
@@ -0,0 +1,167 @@
+//
+//  bit grid.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_bit_grid_hpp
+#define engine_grid_bit_grid_hpp
+
+#include "grid.hpp"
+
+namespace Grid {
+  /// A grid of bits packed 64 to a word. Bits are stored in the same order as
+  /// a row-major Grid so the index of a tile is the index of its bit. Rows are
+  /// not padded so a 64 bit window of a row may span two words. Scans, counts
+  /// and bitwise operations work on 64 tiles at a time. When used for
+  /// pathfinding, set bits are not path (like the notPath predicate).
+  class BitGrid {
+  public:
+    using Word = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    BitGrid();
+    BitGrid(Coord, Coord, bool = false);
+    explicit BitGrid(Pos, bool = false);
+
+    void resize(Pos, bool = false);
+    void fill(bool);
+
+    Pos size() const {
+      return mSize;
+    }
+    Coord width() const {
+      return mSize.x;
+    }
+    Coord height() const {
+      return mSize.y;
+    }
+    size_t area() const {
+      return static_cast<size_t>(mSize.x) * static_cast<size_t>(mSize.y);
+    }
+
+    bool outOfRange(const Pos pos) const {
+      return pos.x < 0 || pos.y < 0 || pos.x >= mSize.x || pos.y >= mSize.y;
+    }
+    bool outOfRange(const size_t index) const {
+      return index >= area();
+    }
+    size_t toIndex(const Pos pos) const {
+      assert(!outOfRange(pos));
+      return static_cast<size_t>(pos.y) * static_cast<size_t>(mSize.x) + static_cast<size_t>(pos.x);
+    }
+    Pos toPos(const size_t index) const {
+      assert(!outOfRange(index));
+      const Coord cindex = static_cast<Coord>(index);
+      return {cindex % mSize.x, cindex / mSize.x};
+    }
+
+    bool operator()(const Coord x, const Coord y) const {
+      return (*this)[toIndex({x, y})];
+    }
+    bool operator[](const Pos pos) const {
+      return (*this)[toIndex(pos)];
+    }
+    bool operator[](const size_t index) const {
+      assert(!outOfRange(index));
+      return (mWords[index / word_bits] >> (index % word_bits)) & 1;
+    }
+    bool at(Pos) const;
+
+    void set(Pos, bool = true);
+    void reset(Pos);
+    void flip(Pos);
+
+    /// Get 64 bits starting at a bit index. Bits past the end are 0
+    Word bits(size_t) const;
+    /// Get 64 bits of a row starting at a position. Bit 0 is the tile at the
+    /// position. Bits past the end of the row are 0
+    Word rowBits(Pos) const;
+    /// Get 64 bits of a row ending at a position. Bit 63 is the tile at the
+    /// position. Bits before the start of the row are 0
+    Word rowBitsBefore(Pos) const;
+
+    /// Number of set bits
+    size_t count() const;
+    /// Are any bits set?
+    bool any() const;
+    /// Are no bits set?
+    bool none() const;
+
+    /// Find the first set bit in the row at or after the position. Returns
+    /// the width if there isn't one
+    Coord nextSet(Pos) const;
+    /// Find the first clear bit in the row at or after the position. Returns
+    /// the width if there isn't one
+    Coord nextClear(Pos) const;
+    /// Find the last set bit in the row at or before the position. Returns -1
+    /// if there isn't one
+    Coord prevSet(Pos) const;
+    /// Find the last clear bit in the row at or before the position. Returns
+    /// -1 if there isn't one
+    Coord prevClear(Pos) const;
+    /// Find the first set bit in the column at or above the position. Returns
+    /// the height if there isn't one
+    Coord nextSetVert(Pos) const;
+    /// Find the first clear bit in the column at or above the position.
+    /// Returns the height if there isn't one
+    Coord nextClearVert(Pos) const;
+    /// Find the last set bit in the column at or below the position. Returns
+    /// -1 if there isn't one
+    Coord prevSetVert(Pos) const;
+    /// Find the last clear bit in the column at or below the position.
+    /// Returns -1 if there isn't one
+    Coord prevClearVert(Pos) const;
+
+    BitGrid &operator&=(const BitGrid &);
+    BitGrid &operator|=(const BitGrid &);
+    BitGrid &operator^=(const BitGrid &);
+    /// Clear the bits that are set in the other grid
+    BitGrid &andNot(const BitGrid &);
+    BitGrid operator~() const;
+
+    const Word *data() const {
+      return mWords.data();
+    }
+    Word *data() {
+      return mWords.data();
+    }
+    /// Number of words that hold bits. There is a padding word after these
+    size_t numWords() const {
+      return (area() + word_bits - 1) / word_bits;
+    }
+
+  private:
+    // there is always a zero word at the end so that bits() can read past the
+    // last word
+    std::vector<Word> mWords;
+    Pos mSize;
+
+    Word lastMask() const;
+    void clearPadding();
+    size_t findSet(size_t, size_t, Word) const;
+    size_t findLastSet(size_t, size_t, Word) const;
+    Coord findVert(Pos, Coord, bool) const;
+  };
+
+  inline BitGrid operator&(BitGrid a, const BitGrid &b) {
+    return a &= b;
+  }
+  inline BitGrid operator|(BitGrid a, const BitGrid &b) {
+    return a |= b;
+  }
+  inline BitGrid operator^(BitGrid a, const BitGrid &b) {
+    return a ^= b;
+  }
+
+  /// Create a bit grid from a grid. Bits are set where the predicate returns
+  /// true
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  BitGrid makeBitGrid(const Grid<Tile, Width, Height, Layout> &, Function &&);
+}
+
+#include "bit grid.inl"
+
+#endif
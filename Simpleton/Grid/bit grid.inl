@@ -0,0 +1,281 @@
+//
+//  bit grid.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <stdexcept>
+
+inline Grid::BitGrid::BitGrid()
+  : mWords(1, 0), mSize{0, 0} {}
+
+inline Grid::BitGrid::BitGrid(const Coord width, const Coord height, const bool bit)
+  : BitGrid{} {
+  resize({width, height}, bit);
+}
+
+inline Grid::BitGrid::BitGrid(const Pos size, const bool bit)
+  : BitGrid{size.x, size.y, bit} {}
+
+inline void Grid::BitGrid::resize(const Pos size, const bool bit) {
+  assert(size.x > 0);
+  assert(size.y > 0);
+  mSize = size;
+  mWords.assign(numWords() + 1, 0);
+  fill(bit);
+}
+
+inline void Grid::BitGrid::fill(const bool bit) {
+  std::fill(mWords.begin(), mWords.end(), bit ? ~Word{} : Word{});
+  clearPadding();
+}
+
+inline bool Grid::BitGrid::at(const Pos pos) const {
+  if (outOfRange(pos)) {
+    throw std::range_error("Position out of range");
+  }
+  return (*this)[pos];
+}
+
+inline void Grid::BitGrid::set(const Pos pos, const bool bit) {
+  const size_t index = toIndex(pos);
+  const Word mask = Word{1} << (index % word_bits);
+  Word &word = mWords[index / word_bits];
+  word = bit ? (word | mask) : (word & ~mask);
+}
+
+inline void Grid::BitGrid::reset(const Pos pos) {
+  set(pos, false);
+}
+
+inline void Grid::BitGrid::flip(const Pos pos) {
+  const size_t index = toIndex(pos);
+  mWords[index / word_bits] ^= Word{1} << (index % word_bits);
+}
+
+inline Grid::BitGrid::Word Grid::BitGrid::bits(const size_t index) const {
+  const size_t word = index / word_bits;
+  const size_t shift = index % word_bits;
+  if (word >= mWords.size()) {
+    return 0;
+  }
+  if (shift == 0) {
+    return mWords[word];
+  }
+  const Word high = word + 1 < mWords.size() ? mWords[word + 1] : 0;
+  return (mWords[word] >> shift) | (high << (word_bits - shift));
+}
+
+inline Grid::BitGrid::Word Grid::BitGrid::rowBits(const Pos pos) const {
+  const size_t remaining = static_cast<size_t>(mSize.x - pos.x);
+  const Word word = bits(toIndex(pos));
+  return remaining >= word_bits ? word : word & ((Word{1} << remaining) - 1);
+}
+
+inline Grid::BitGrid::Word Grid::BitGrid::rowBitsBefore(const Pos pos) const {
+  const size_t index = toIndex(pos);
+  const size_t before = static_cast<size_t>(pos.x) + 1;
+  if (before >= word_bits) {
+    return bits(index + 1 - word_bits);
+  }
+  // shift the row start up to the top of the word
+  return bits(index + 1 - before) << (word_bits - before);
+}
+
+inline size_t Grid::BitGrid::count() const {
+  size_t total = 0;
+  for (const Word word : mWords) {
+    total += static_cast<size_t>(__builtin_popcountll(word));
+  }
+  return total;
+}
+
+inline bool Grid::BitGrid::any() const {
+  for (const Word word : mWords) {
+    if (word) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool Grid::BitGrid::none() const {
+  return !any();
+}
+
+inline Grid::Coord Grid::BitGrid::nextSet(const Pos pos) const {
+  const size_t rowBegin = toIndex({0, pos.y});
+  const size_t end = rowBegin + static_cast<size_t>(mSize.x);
+  return static_cast<Coord>(findSet(toIndex(pos), end, 0) - rowBegin);
+}
+
+inline Grid::Coord Grid::BitGrid::nextClear(const Pos pos) const {
+  const size_t rowBegin = toIndex({0, pos.y});
+  const size_t end = rowBegin + static_cast<size_t>(mSize.x);
+  return static_cast<Coord>(findSet(toIndex(pos), end, ~Word{}) - rowBegin);
+}
+
+inline Grid::Coord Grid::BitGrid::prevSet(const Pos pos) const {
+  const size_t rowBegin = toIndex({0, pos.y});
+  const size_t found = findLastSet(rowBegin, toIndex(pos) + 1, 0);
+  return found == toIndex(pos) + 1 ? -1 : static_cast<Coord>(found - rowBegin);
+}
+
+inline Grid::Coord Grid::BitGrid::prevClear(const Pos pos) const {
+  const size_t rowBegin = toIndex({0, pos.y});
+  const size_t found = findLastSet(rowBegin, toIndex(pos) + 1, ~Word{});
+  return found == toIndex(pos) + 1 ? -1 : static_cast<Coord>(found - rowBegin);
+}
+
+inline Grid::Coord Grid::BitGrid::nextSetVert(const Pos pos) const {
+  return findVert(pos, 1, true);
+}
+
+inline Grid::Coord Grid::BitGrid::nextClearVert(const Pos pos) const {
+  return findVert(pos, 1, false);
+}
+
+inline Grid::Coord Grid::BitGrid::prevSetVert(const Pos pos) const {
+  return findVert(pos, -1, true);
+}
+
+inline Grid::Coord Grid::BitGrid::prevClearVert(const Pos pos) const {
+  return findVert(pos, -1, false);
+}
+
+inline Grid::BitGrid &Grid::BitGrid::operator&=(const BitGrid &other) {
+  assert(mSize == other.mSize);
+  for (size_t w = 0; w != mWords.size(); ++w) {
+    mWords[w] &= other.mWords[w];
+  }
+  return *this;
+}
+
+inline Grid::BitGrid &Grid::BitGrid::operator|=(const BitGrid &other) {
+  assert(mSize == other.mSize);
+  for (size_t w = 0; w != mWords.size(); ++w) {
+    mWords[w] |= other.mWords[w];
+  }
+  return *this;
+}
+
+inline Grid::BitGrid &Grid::BitGrid::operator^=(const BitGrid &other) {
+  assert(mSize == other.mSize);
+  for (size_t w = 0; w != mWords.size(); ++w) {
+    mWords[w] ^= other.mWords[w];
+  }
+  return *this;
+}
+
+inline Grid::BitGrid &Grid::BitGrid::andNot(const BitGrid &other) {
+  assert(mSize == other.mSize);
+  for (size_t w = 0; w != mWords.size(); ++w) {
+    mWords[w] &= ~other.mWords[w];
+  }
+  return *this;
+}
+
+inline Grid::BitGrid Grid::BitGrid::operator~() const {
+  BitGrid inverse = *this;
+  for (Word &word : inverse.mWords) {
+    word = ~word;
+  }
+  inverse.clearPadding();
+  return inverse;
+}
+
+inline Grid::BitGrid::Word Grid::BitGrid::lastMask() const {
+  const size_t used = area() % word_bits;
+  return used == 0 ? ~Word{} : (Word{1} << used) - 1;
+}
+
+inline void Grid::BitGrid::clearPadding() {
+  const size_t words = numWords();
+  if (words != 0) {
+    mWords[words - 1] &= lastMask();
+  }
+  std::fill(mWords.begin() + static_cast<std::ptrdiff_t>(words), mWords.end(), Word{});
+}
+
+// Find the first set bit in [begin, end) after xoring each word with flip.
+// Returns end if there isn't one
+inline size_t Grid::BitGrid::findSet(
+  size_t begin,
+  const size_t end,
+  const Word flip
+) const {
+  while (begin < end) {
+    Word word = bits(begin) ^ flip;
+    const size_t remaining = end - begin;
+    if (remaining < word_bits) {
+      word &= (Word{1} << remaining) - 1;
+    }
+    if (word) {
+      return begin + static_cast<size_t>(__builtin_ctzll(word));
+    }
+    begin += word_bits;
+  }
+  return end;
+}
+
+// Find the last set bit in [begin, end) after xoring each word with flip.
+// Returns end if there isn't one
+inline size_t Grid::BitGrid::findLastSet(
+  const size_t begin,
+  const size_t end,
+  const Word flip
+) const {
+  size_t top = end;
+  while (top > begin) {
+    const size_t remaining = top - begin;
+    Word word;
+    size_t base;
+    if (remaining >= word_bits) {
+      base = top - word_bits;
+      word = bits(base) ^ flip;
+    } else {
+      base = begin;
+      word = (bits(base) ^ flip) & ((Word{1} << remaining) - 1);
+    }
+    if (word) {
+      return base + word_bits - 1 - static_cast<size_t>(__builtin_clzll(word));
+    }
+    top = base;
+  }
+  return end;
+}
+
+inline Grid::Coord Grid::BitGrid::findVert(
+  const Pos pos,
+  const Coord step,
+  const bool bit
+) const {
+  // columns are strided so there is nothing to gain from whole words
+  for (Coord y = pos.y; y >= 0 && y < mSize.y; y += step) {
+    if ((*this)(pos.x, y) == bit) {
+      return y;
+    }
+  }
+  return step > 0 ? mSize.y : -1;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::BitGrid Grid::makeBitGrid(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&pred
+) {
+  BitGrid bits{grid.size()};
+  BitGrid::Word *words = bits.data();
+  size_t index = 0;
+  for (const Coord y : grid.vert()) {
+    for (const Coord x : grid.hori()) {
+      if (pred(grid(x, y))) {
+        words[index / BitGrid::word_bits] |= BitGrid::Word{1} << (index % BitGrid::word_bits);
+      }
+      ++index;
+    }
+  }
+  return bits;
+}
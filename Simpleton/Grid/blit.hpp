@@ -10,22 +10,52 @@
 #define engine_grid_blit_hpp
 
 #include "grid.hpp"
+#include "../Utils/parallel for.hpp"
 
 namespace Grid {
-  template <typename Tile, Coord DstWidth, Coord DstHeight, Coord SrcWidth, Coord SrcHeight, typename Func>
+  /// Copy a grid onto another grid at a position. Tiles that fall outside of
+  /// the destination are clipped. The function is called with the
+  /// destination tile and the source tile
+  template <typename Tile, Coord DstWidth, Coord DstHeight, typename DstLayout, Coord SrcWidth, Coord SrcHeight, typename SrcLayout, typename Func>
   void blit(
-    Grid<Tile, DstWidth, DstHeight> &,
-    const Grid<Tile, SrcWidth, SrcHeight> &,
+    Grid<Tile, DstWidth, DstHeight, DstLayout> &,
+    const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &,
     Func &&,
     Pos = {0, 0}
   );
   
-  template <typename Tile, Coord DstWidth, Coord DstHeight, Coord SrcWidth, Coord SrcHeight>
+  /// Copy a grid onto another grid at a position. If both grids are row
+  /// major, rows of trivially copyable tiles are copied with memcpy
+  template <typename Tile, Coord DstWidth, Coord DstHeight, typename DstLayout, Coord SrcWidth, Coord SrcHeight, typename SrcLayout>
   void blit(
-    Grid<Tile, DstWidth, DstHeight> &,
-    const Grid<Tile, SrcWidth, SrcHeight> &,
+    Grid<Tile, DstWidth, DstHeight, DstLayout> &,
+    const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &,
     Pos = {0, 0}
   );
+  
+  /// Copy a grid onto another grid at a position with the rows spread across
+  /// multiple threads. The function must be safe to call from multiple
+  /// threads
+  template <typename Tile, Coord DstWidth, Coord DstHeight, typename DstLayout, Coord SrcWidth, Coord SrcHeight, typename SrcLayout, typename Func>
+  void blit(
+    Utils::parallel_t,
+    Grid<Tile, DstWidth, DstHeight, DstLayout> &,
+    const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &,
+    Func &&,
+    Pos = {0, 0},
+    unsigned = 0
+  );
+  
+  /// Copy a grid onto another grid at a position with the rows spread across
+  /// multiple threads
+  template <typename Tile, Coord DstWidth, Coord DstHeight, typename DstLayout, Coord SrcWidth, Coord SrcHeight, typename SrcLayout>
+  void blit(
+    Utils::parallel_t,
+    Grid<Tile, DstWidth, DstHeight, DstLayout> &,
+    const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &,
+    Pos = {0, 0},
+    unsigned = 0
+  );
 }
 
 #include "blit.inl"
@@ -6,30 +6,128 @@
 //  Copyright © 2018 Indi Kernick. All rights reserved.
 //
 
+#include <cstring>
 #include <algorithm>
 
+namespace Grid::detail {
+  // rows per task when blitting in parallel
+  constexpr Coord blit_rows_per_task = 16;
+
+  struct BlitRect {
+    Pos min;
+    Pos max;
+    
+    bool empty() const {
+      return min.x >= max.x || min.y >= max.y;
+    }
+  };
+
+  // the area of the destination that the source covers
+  template <typename DstGrid, typename SrcGrid>
+  BlitRect blitRect(const DstGrid &dst, const SrcGrid &src, const Pos pos) {
+    const Coord loX = std::min(pos.x, dst.width());
+    const Coord loY = std::min(pos.y, dst.height());
+    const Coord hiX = std::min(loX + src.width(), dst.width());
+    const Coord hiY = std::min(loY + src.height(), dst.height());
+    return {
+      {std::max(loX, 0), std::max(loY, 0)},
+      {std::max(hiX, 0), std::max(hiY, 0)}
+    };
+  }
+
+  template <typename DstGrid, typename SrcGrid, typename Func>
+  void blitRow(
+    DstGrid &dst,
+    const SrcGrid &src,
+    Func &copy,
+    const Pos pos,
+    const BlitRect rect,
+    const Coord y
+  ) {
+    using Tile = typename DstGrid::Tile;
+    if constexpr (
+      row_major_tiles<Tile, DstGrid::Width, typename DstGrid::Layout> &&
+      row_major_tiles<Tile, SrcGrid::Width, typename SrcGrid::Layout>
+    ) {
+      // the index only needs to be calculated once for each row
+      Tile *dstRow = dst.data() + dst.toIndex({rect.min.x, y});
+      const Tile *srcRow = src.data() + src.toIndex({rect.min.x - pos.x, y - pos.y});
+      const size_t width = static_cast<size_t>(rect.max.x - rect.min.x);
+      for (size_t x = 0; x != width; ++x) {
+        copy(dstRow[x], srcRow[x]);
+      }
+    } else {
+      for (Coord x = rect.min.x; x != rect.max.x; ++x) {
+        copy(dst(x, y), src(x - pos.x, y - pos.y));
+      }
+    }
+  }
+
+  template <typename DstGrid, typename SrcGrid>
+  void blitRow(
+    DstGrid &dst,
+    const SrcGrid &src,
+    const Pos pos,
+    const BlitRect rect,
+    const Coord y
+  ) {
+    using Tile = typename DstGrid::Tile;
+    if constexpr (
+      row_major_tiles<Tile, DstGrid::Width, typename DstGrid::Layout> &&
+      row_major_tiles<Tile, SrcGrid::Width, typename SrcGrid::Layout>
+    ) {
+      Tile *dstRow = dst.data() + dst.toIndex({rect.min.x, y});
+      const Tile *srcRow = src.data() + src.toIndex({rect.min.x - pos.x, y - pos.y});
+      const size_t width = static_cast<size_t>(rect.max.x - rect.min.x);
+      if constexpr (std::is_trivially_copyable_v<Tile>) {
+        std::memcpy(dstRow, srcRow, width * sizeof(Tile));
+      } else {
+        std::copy(srcRow, srcRow + width, dstRow);
+      }
+    } else {
+      for (Coord x = rect.min.x; x != rect.max.x; ++x) {
+        dst(x, y) = src(x - pos.x, y - pos.y);
+      }
+    }
+  }
+
+  // call a function with each band of rows in parallel
+  template <typename Function>
+  void blitParallel(const BlitRect rect, Function &&function, const unsigned threads) {
+    const Coord rows = rect.max.y - rect.min.y;
+    const Coord tasks = (rows + blit_rows_per_task - 1) / blit_rows_per_task;
+    Utils::parallelFor(0, static_cast<size_t>(tasks), [&] (const size_t task) {
+      const Coord begin = rect.min.y + static_cast<Coord>(task) * blit_rows_per_task;
+      const Coord end = std::min(begin + blit_rows_per_task, rect.max.y);
+      for (Coord y = begin; y != end; ++y) {
+        function(y);
+      }
+    }, threads);
+  }
+}
+
 template <
   typename Tile,
   Grid::Coord DstWidth,
   Grid::Coord DstHeight,
+  typename DstLayout,
   Grid::Coord SrcWidth,
   Grid::Coord SrcHeight,
+  typename SrcLayout,
   typename Func
 >
 void Grid::blit(
-  Grid<Tile, DstWidth, DstHeight> &dst,
-  const Grid<Tile, SrcWidth, SrcHeight> &src,
+  Grid<Tile, DstWidth, DstHeight, DstLayout> &dst,
+  const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &src,
   Func &&copy,
   const Pos pos
 ) {
-  const Coord loX = std::min(pos.x, dst.width());
-  const Coord loY = std::min(pos.y, dst.height());
-  const Coord hiX = std::min(loX + src.width(), dst.width());
-  const Coord hiY = std::min(loY + src.height(), dst.height());
-  for (Coord y = std::max(loY, 0); y != std::max(hiY, 0); ++y) {
-    for (Coord x = std::max(loX, 0); x != std::max(hiX, 0); ++x) {
-      copy(dst(x, y), src(x - pos.x, y - pos.y));
-    }
+  const detail::BlitRect rect = detail::blitRect(dst, src, pos);
+  if (rect.empty()) {
+    return;
+  }
+  for (Coord y = rect.min.y; y != rect.max.y; ++y) {
+    detail::blitRow(dst, src, copy, pos, rect, y);
   }
 }
 
@@ -37,15 +135,81 @@ template <
   typename Tile,
   Grid::Coord DstWidth,
   Grid::Coord DstHeight,
+  typename DstLayout,
   Grid::Coord SrcWidth,
-  Grid::Coord SrcHeight
+  Grid::Coord SrcHeight,
+  typename SrcLayout
 >
 void Grid::blit(
-  Grid<Tile, DstWidth, DstHeight> &dst,
-  const Grid<Tile, SrcWidth, SrcHeight> &src,
+  Grid<Tile, DstWidth, DstHeight, DstLayout> &dst,
+  const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &src,
   const Pos pos
 ) {
-  blit(dst, src, [] (Tile &dstTile, const Tile &srcTile) {
-    dstTile = srcTile;
-  }, pos);
+  const detail::BlitRect rect = detail::blitRect(dst, src, pos);
+  if (rect.empty()) {
+    return;
+  }
+  for (Coord y = rect.min.y; y != rect.max.y; ++y) {
+    detail::blitRow(dst, src, pos, rect, y);
+  }
+}
+
+template <
+  typename Tile,
+  Grid::Coord DstWidth,
+  Grid::Coord DstHeight,
+  typename DstLayout,
+  Grid::Coord SrcWidth,
+  Grid::Coord SrcHeight,
+  typename SrcLayout,
+  typename Func
+>
+void Grid::blit(
+  Utils::parallel_t,
+  Grid<Tile, DstWidth, DstHeight, DstLayout> &dst,
+  const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &src,
+  Func &&copy,
+  const Pos pos,
+  const unsigned threads
+) {
+  static_assert(
+    detail::contiguous_tiles<Tile, DstWidth>,
+    "Threads can't write to neighboring bits of a std::vector<bool>"
+  );
+  const detail::BlitRect rect = detail::blitRect(dst, src, pos);
+  if (rect.empty()) {
+    return;
+  }
+  detail::blitParallel(rect, [&] (const Coord y) {
+    detail::blitRow(dst, src, copy, pos, rect, y);
+  }, threads);
+}
+
+template <
+  typename Tile,
+  Grid::Coord DstWidth,
+  Grid::Coord DstHeight,
+  typename DstLayout,
+  Grid::Coord SrcWidth,
+  Grid::Coord SrcHeight,
+  typename SrcLayout
+>
+void Grid::blit(
+  Utils::parallel_t,
+  Grid<Tile, DstWidth, DstHeight, DstLayout> &dst,
+  const Grid<Tile, SrcWidth, SrcHeight, SrcLayout> &src,
+  const Pos pos,
+  const unsigned threads
+) {
+  static_assert(
+    detail::contiguous_tiles<Tile, DstWidth>,
+    "Threads can't write to neighboring bits of a std::vector<bool>"
+  );
+  const detail::BlitRect rect = detail::blitRect(dst, src, pos);
+  if (rect.empty()) {
+    return;
+  }
+  detail::blitParallel(rect, [&] (const Coord y) {
+    detail::blitRow(dst, src, pos, rect, y);
+  }, threads);
 }
@@ -0,0 +1,233 @@
+//
+//  chunked grid.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_chunked_grid_hpp
+#define engine_grid_chunked_grid_hpp
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include "pos.hpp"
+#include "../Utils/numeric iterators.hpp"
+
+namespace Grid {
+  /// A sparse grid for very large worlds. Tiles are stored in square chunks
+  /// that are allocated the first time a tile in the chunk is written to.
+  /// Reading a tile in an unallocated chunk returns the default tile so memory
+  /// use is proportional to the number of chunks that have been written to.
+  /// Released chunks are kept in a pool and reused. Iterating the grid visits
+  /// the allocated chunks.
+  template <typename Tile_, Coord ChunkSize_ = 64>
+  class ChunkedGrid {
+  public:
+    using Tile = Tile_;
+    static constexpr Coord chunk_size = ChunkSize_;
+    static constexpr size_t chunk_area = static_cast<size_t>(chunk_size * chunk_size);
+
+    static_assert(chunk_size > 0 && (chunk_size & (chunk_size - 1)) == 0, "Chunk size must be a power of 2");
+
+    class Chunk {
+    public:
+      friend ChunkedGrid;
+      using Tiles = std::array<Tile, chunk_area>;
+
+      /// Position of the bottom left tile of the chunk
+      Pos pos() const {
+        return mPos;
+      }
+
+      auto begin() {
+        return mTiles.begin();
+      }
+      auto begin() const {
+        return mTiles.begin();
+      }
+      auto end() {
+        return mTiles.end();
+      }
+      auto end() const {
+        return mTiles.end();
+      }
+
+      auto hori() const {
+        return Utils::range(chunk_size);
+      }
+      auto vert() const {
+        return Utils::range(chunk_size);
+      }
+
+      /// Access a tile relative to the bottom left of the chunk
+      Tile &operator()(const Coord x, const Coord y) {
+        return mTiles[toIndex({x, y})];
+      }
+      const Tile &operator()(const Coord x, const Coord y) const {
+        return mTiles[toIndex({x, y})];
+      }
+      Tile &operator[](const Pos pos) {
+        return mTiles[toIndex(pos)];
+      }
+      const Tile &operator[](const Pos pos) const {
+        return mTiles[toIndex(pos)];
+      }
+
+    private:
+      Tiles mTiles;
+      Pos mPos;
+      size_t liveIndex;
+
+      static size_t toIndex(const Pos pos) {
+        assert(pos.x >= 0 && pos.y >= 0 && pos.x < chunk_size && pos.y < chunk_size);
+        return static_cast<size_t>(pos.y * chunk_size + pos.x);
+      }
+    };
+
+    template <typename ChunkType>
+    class Iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = ChunkType;
+      using difference_type = std::ptrdiff_t;
+      using pointer = ChunkType *;
+      using reference = ChunkType &;
+
+      explicit Iterator(Chunk *const *const ptr)
+        : ptr{ptr} {}
+
+      reference operator*() const {
+        return **ptr;
+      }
+      pointer operator->() const {
+        return *ptr;
+      }
+      Iterator &operator++() {
+        ++ptr;
+        return *this;
+      }
+      Iterator operator++(int) {
+        return Iterator{ptr++};
+      }
+      bool operator==(const Iterator other) const {
+        return ptr == other.ptr;
+      }
+      bool operator!=(const Iterator other) const {
+        return ptr != other.ptr;
+      }
+
+    private:
+      Chunk *const *ptr;
+    };
+
+    ChunkedGrid();
+    ChunkedGrid(Coord, Coord, const Tile & = {});
+    explicit ChunkedGrid(Pos, const Tile & = {});
+
+    ChunkedGrid(ChunkedGrid &&) = default;
+    ChunkedGrid &operator=(ChunkedGrid &&) = default;
+
+    /// Release every chunk and change the size
+    void resize(Pos, const Tile & = {});
+
+    Pos size() const {
+      return mSize;
+    }
+    Coord width() const {
+      return mSize.x;
+    }
+    Coord height() const {
+      return mSize.y;
+    }
+    size_t area() const {
+      return static_cast<size_t>(mSize.x) * static_cast<size_t>(mSize.y);
+    }
+    bool outOfRange(const Pos pos) const {
+      return pos.x < 0 || pos.y < 0 || pos.x >= mSize.x || pos.y >= mSize.y;
+    }
+    /// The tile that is returned for tiles in unallocated chunks
+    const Tile &defaultTile() const {
+      return mDefault;
+    }
+
+    /// Get a tile without allocating a chunk
+    const Tile &operator()(Coord, Coord) const;
+    /// Get a tile. This allocates the chunk if it isn't allocated
+    Tile &operator()(Coord, Coord);
+    /// Get a tile without allocating a chunk
+    const Tile &operator[](Pos) const;
+    /// Get a tile. This allocates the chunk if it isn't allocated
+    Tile &operator[](Pos);
+    const Tile &at(Pos) const;
+    Tile &at(Pos);
+
+    /// Is the chunk containing the tile allocated?
+    bool allocated(Pos) const;
+    /// Get the chunk containing the tile. This allocates the chunk if it isn't
+    /// allocated
+    Chunk &chunk(Pos);
+    /// Get the chunk containing the tile or null if it isn't allocated
+    const Chunk *findChunk(Pos) const;
+
+    /// Return the chunk containing the tile to the pool. The tiles in the
+    /// chunk become the default tile
+    void release(Pos);
+    /// Return all chunks that only contain the default tile to the pool
+    void shrink();
+    /// Return all chunks to the pool
+    void clear();
+    /// Free the memory used by the chunks in the pool
+    void freePool();
+
+    /// Number of allocated chunks
+    size_t numChunks() const {
+      return live.size();
+    }
+    /// Number of chunks in the pool that are ready to be reused
+    size_t numPooled() const {
+      return pool.size();
+    }
+
+    Iterator<Chunk> begin() {
+      return Iterator<Chunk>{live.data()};
+    }
+    Iterator<const Chunk> begin() const {
+      return Iterator<const Chunk>{live.data()};
+    }
+    Iterator<Chunk> end() {
+      return Iterator<Chunk>{live.data() + live.size()};
+    }
+    Iterator<const Chunk> end() const {
+      return Iterator<const Chunk>{live.data() + live.size()};
+    }
+
+  private:
+    static constexpr Coord chunk_shift = __builtin_ctz(static_cast<unsigned>(chunk_size));
+    static constexpr Coord chunk_mask = chunk_size - 1;
+
+    // every chunk that has ever been allocated
+    std::vector<std::unique_ptr<Chunk>> storage;
+    // chunks that have been released
+    std::vector<Chunk *> pool;
+    // allocated chunks
+    std::vector<Chunk *> live;
+    // the chunk at each chunk position or null
+    std::vector<Chunk *> table;
+    Pos chunksSize;
+    Pos mSize;
+    Tile mDefault;
+
+    size_t tableIndex(Pos) const;
+    static size_t localIndex(Pos);
+    Chunk *allocChunk(Pos);
+    void releaseChunk(Chunk *);
+  };
+}
+
+#include "chunked grid.inl"
+
+#endif
@@ -0,0 +1,195 @@
+//
+//  chunked grid.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <stdexcept>
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::ChunkedGrid<Tile, ChunkSize>::ChunkedGrid()
+  : chunksSize{0, 0}, mSize{0, 0}, mDefault{} {}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::ChunkedGrid<Tile, ChunkSize>::ChunkedGrid(
+  const Coord width,
+  const Coord height,
+  const Tile &tile
+) : ChunkedGrid{} {
+  resize({width, height}, tile);
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::ChunkedGrid<Tile, ChunkSize>::ChunkedGrid(const Pos size, const Tile &tile)
+  : ChunkedGrid{size.x, size.y, tile} {}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::ChunkedGrid<Tile, ChunkSize>::resize(const Pos size, const Tile &tile) {
+  assert(size.x > 0);
+  assert(size.y > 0);
+  clear();
+  mSize = size;
+  mDefault = tile;
+  chunksSize = {
+    (size.x + chunk_mask) >> chunk_shift,
+    (size.y + chunk_mask) >> chunk_shift
+  };
+  table.assign(static_cast<size_t>(chunksSize.x) * static_cast<size_t>(chunksSize.y), nullptr);
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+const Tile &Grid::ChunkedGrid<Tile, ChunkSize>::operator()(
+  const Coord x,
+  const Coord y
+) const {
+  return (*this)[Pos{x, y}];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Tile &Grid::ChunkedGrid<Tile, ChunkSize>::operator()(const Coord x, const Coord y) {
+  return (*this)[Pos{x, y}];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+const Tile &Grid::ChunkedGrid<Tile, ChunkSize>::operator[](const Pos pos) const {
+  const Chunk *const chunk = table[tableIndex(pos)];
+  return chunk ? chunk->mTiles[localIndex(pos)] : mDefault;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Tile &Grid::ChunkedGrid<Tile, ChunkSize>::operator[](const Pos pos) {
+  Chunk *&chunk = table[tableIndex(pos)];
+  if (chunk == nullptr) {
+    chunk = allocChunk(pos);
+  }
+  return chunk->mTiles[localIndex(pos)];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+const Tile &Grid::ChunkedGrid<Tile, ChunkSize>::at(const Pos pos) const {
+  if (outOfRange(pos)) {
+    throw std::range_error("Position out of range");
+  }
+  return (*this)[pos];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Tile &Grid::ChunkedGrid<Tile, ChunkSize>::at(const Pos pos) {
+  if (outOfRange(pos)) {
+    throw std::range_error("Position out of range");
+  }
+  return (*this)[pos];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+bool Grid::ChunkedGrid<Tile, ChunkSize>::allocated(const Pos pos) const {
+  return table[tableIndex(pos)] != nullptr;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+auto Grid::ChunkedGrid<Tile, ChunkSize>::chunk(const Pos pos) -> Chunk & {
+  Chunk *&chunk = table[tableIndex(pos)];
+  if (chunk == nullptr) {
+    chunk = allocChunk(pos);
+  }
+  return *chunk;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+auto Grid::ChunkedGrid<Tile, ChunkSize>::findChunk(const Pos pos) const -> const Chunk * {
+  return table[tableIndex(pos)];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::ChunkedGrid<Tile, ChunkSize>::release(const Pos pos) {
+  Chunk *&chunk = table[tableIndex(pos)];
+  if (chunk != nullptr) {
+    releaseChunk(chunk);
+    chunk = nullptr;
+  }
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::ChunkedGrid<Tile, ChunkSize>::shrink() {
+  // iterate backwards because releasing a chunk moves the last chunk
+  for (size_t c = live.size(); c != 0; --c) {
+    Chunk *const chunk = live[c - 1];
+    bool empty = true;
+    for (const Tile &tile : chunk->mTiles) {
+      if (!(tile == mDefault)) {
+        empty = false;
+        break;
+      }
+    }
+    if (empty) {
+      table[tableIndex(chunk->mPos)] = nullptr;
+      releaseChunk(chunk);
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::ChunkedGrid<Tile, ChunkSize>::clear() {
+  for (Chunk *const chunk : live) {
+    table[tableIndex(chunk->mPos)] = nullptr;
+    pool.push_back(chunk);
+  }
+  live.clear();
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::ChunkedGrid<Tile, ChunkSize>::freePool() {
+  if (pool.empty()) {
+    return;
+  }
+  pool.clear();
+  std::vector<std::unique_ptr<Chunk>> kept;
+  kept.reserve(live.size());
+  for (std::unique_ptr<Chunk> &chunk : storage) {
+    const size_t index = chunk->liveIndex;
+    if (index < live.size() && live[index] == chunk.get()) {
+      kept.push_back(std::move(chunk));
+    }
+  }
+  storage = std::move(kept);
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+size_t Grid::ChunkedGrid<Tile, ChunkSize>::tableIndex(const Pos pos) const {
+  assert(!outOfRange(pos));
+  return static_cast<size_t>(pos.y >> chunk_shift) * static_cast<size_t>(chunksSize.x)
+       + static_cast<size_t>(pos.x >> chunk_shift);
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+size_t Grid::ChunkedGrid<Tile, ChunkSize>::localIndex(const Pos pos) {
+  return static_cast<size_t>(((pos.y & chunk_mask) << chunk_shift) | (pos.x & chunk_mask));
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+auto Grid::ChunkedGrid<Tile, ChunkSize>::allocChunk(const Pos pos) -> Chunk * {
+  Chunk *chunk;
+  if (pool.empty()) {
+    storage.push_back(std::make_unique<Chunk>());
+    chunk = storage.back().get();
+  } else {
+    chunk = pool.back();
+    pool.pop_back();
+  }
+  chunk->mTiles.fill(mDefault);
+  chunk->mPos = {pos.x & ~chunk_mask, pos.y & ~chunk_mask};
+  chunk->liveIndex = live.size();
+  live.push_back(chunk);
+  return chunk;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::ChunkedGrid<Tile, ChunkSize>::releaseChunk(Chunk *const chunk) {
+  Chunk *const last = live.back();
+  last->liveIndex = chunk->liveIndex;
+  live[chunk->liveIndex] = last;
+  live.pop_back();
+  pool.push_back(chunk);
+}
@@ -0,0 +1,132 @@
+//
+//  corridor graph.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_corridor_graph_hpp
+#define engine_grid_corridor_graph_hpp
+
+#include <array>
+#include "dir.hpp"
+#include "a star.hpp"
+
+namespace Grid {
+  /// A graph of the junctions of a grid and the corridors between them.
+  /// Junctions are path tiles that don't have exactly two path tiles next to
+  /// them (dead ends count as junctions). A corridor is a run of tiles between
+  /// two junctions that has no branches and it is stored as a single edge.
+  /// This is meant for rail and conveyor maps with long corridors where
+  /// onePath would visit every tile. Finding a path is proportional to the
+  /// number of junctions and copying the corridors into the result. Unlike
+  /// onePath, loops and multiple routes are fine and the shortest path is
+  /// found. When a tile changes, only the corridors that touch it are traced
+  /// again.
+  class CorridorGraph {
+  public:
+    using NodeID = uint32_t;
+    using EdgeID = uint32_t;
+    static constexpr uint32_t none = ~uint32_t{};
+
+    CorridorGraph() = default;
+    template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+    CorridorGraph(const Grid<Tile, Width, Height, Layout> &, Function &&);
+    /// Set bits are not path
+    explicit CorridorGraph(const BitGrid &);
+
+    Pos size() const {
+      return walls.size();
+    }
+    bool outOfRange(const Pos pos) const {
+      return walls.outOfRange(pos);
+    }
+
+    /// Is the tile a path tile?
+    bool path(Pos) const;
+    /// Is the tile a junction?
+    bool junction(Pos) const;
+    /// Number of junctions
+    size_t numJunctions() const {
+      return nodes.size() - freeNodes.size();
+    }
+    /// Number of corridors
+    size_t numCorridors() const {
+      return edges.size() - freeEdges.size();
+    }
+
+    /// Find the shortest path between two points. The path includes both
+    /// ends. Returns an empty vector if there is no path or if either point
+    /// is not a path tile
+    std::vector<Pos> onePath(Pos, Pos);
+    /// Find the number of steps on the shortest path between two points
+    /// without creating the path. Returns -1 if there is no path
+    Coord distance(Pos, Pos);
+
+    /// Change a tile into a path tile or into a tile that isn't path
+    void setPath(Pos, bool = true);
+    /// Read a tile that has changed
+    template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+    void update(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos);
+
+  private:
+    // Tiles on a corridor have the ID of the edge and their position along it
+    // (starting at 1). Junctions have an edge of none and the ID of the node.
+    // Tiles that aren't in the graph have none for both
+    struct Slot {
+      EdgeID edge = none;
+      uint32_t index = none;
+    };
+    struct Node {
+      Pos pos;
+      // the edge leaving in each direction
+      std::array<EdgeID, 4> edges;
+      bool alive;
+    };
+    // a corridor from a to b. Offset 0 is a, offset length is b and the tiles
+    // in between are the corridor
+    struct Edge {
+      NodeID a, b;
+      Dir dirA, dirB;
+      std::vector<Pos> tiles;
+
+      Coord length() const {
+        return static_cast<Coord>(tiles.size()) + 1;
+      }
+    };
+    // how a search reached a node
+    struct Via {
+      EdgeID edge;
+      Coord offset;
+      Coord parentOffset;
+    };
+
+    BitGrid walls;
+    Grid<Slot> slots;
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<NodeID> freeNodes;
+    std::vector<EdgeID> freeEdges;
+
+    AStarWorkspace workspace;
+    std::vector<Via> via;
+    std::vector<NodeID> seeds;
+    std::vector<Pos> loose;
+
+    void rebuild();
+    unsigned degree(Pos) const;
+    Pos tileAt(const Edge &, Coord) const;
+
+    NodeID makeNode(Pos);
+    void trace(NodeID);
+    void removeEdge(EdgeID);
+    void removeTile(Pos);
+
+    AStarWorkspace::Index search(Pos, Pos);
+  };
+}
+
+#include "corridor graph.inl"
+
+#endif
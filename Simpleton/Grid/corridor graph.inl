@@ -0,0 +1,334 @@
+//
+//  corridor graph.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::CorridorGraph::CorridorGraph(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath
+) : CorridorGraph{makeBitGrid(grid, notPath)} {}
+
+inline Grid::CorridorGraph::CorridorGraph(const BitGrid &grid)
+  : walls{grid}, slots{grid.size()} {
+  rebuild();
+}
+
+inline bool Grid::CorridorGraph::path(const Pos pos) const {
+  return !walls.outOfRange(pos) && !walls[pos];
+}
+
+inline bool Grid::CorridorGraph::junction(const Pos pos) const {
+  if (walls.outOfRange(pos)) {
+    return false;
+  }
+  const Slot slot = slots[pos];
+  return slot.edge == none && slot.index != none;
+}
+
+inline std::vector<Grid::Pos> Grid::CorridorGraph::onePath(const Pos start, const Pos end) {
+  const AStarWorkspace::Index startIndex = search(start, end);
+  if (startIndex == AStarWorkspace::none) {
+    return {};
+  }
+  std::vector<Pos> path;
+  path.reserve(static_cast<size_t>(workspace.cost(startIndex)) + 1);
+  path.push_back(start);
+
+  // the search went from the end to the start so following the parents
+  // goes forward along the path
+  for (
+    AStarWorkspace::Index i = startIndex;
+    workspace.parent(i) != AStarWorkspace::none;
+    i = workspace.parent(i)
+  ) {
+    const Via step = via[i];
+    const Edge &edge = edges[step.edge];
+    const Coord dir = step.offset < step.parentOffset ? 1 : -1;
+    for (Coord o = step.offset; o != step.parentOffset; ) {
+      o += dir;
+      path.push_back(tileAt(edge, o));
+    }
+  }
+  return path;
+}
+
+inline Grid::Coord Grid::CorridorGraph::distance(const Pos start, const Pos end) {
+  const AStarWorkspace::Index startIndex = search(start, end);
+  if (startIndex == AStarWorkspace::none) {
+    return -1;
+  }
+  return workspace.cost(startIndex);
+}
+
+inline void Grid::CorridorGraph::setPath(const Pos pos, const bool isPath) {
+  if (path(pos) == isPath) {
+    return;
+  }
+  assert(!walls.outOfRange(pos));
+
+  // the tile and its neighbors might change between being junctions and
+  // being part of a corridor so every edge that touches them is removed
+  seeds.clear();
+  loose.clear();
+  removeTile(pos);
+  for (const Dir dir : dir_range) {
+    removeTile(pos + toVec<Coord>(dir));
+  }
+  walls.set(pos, !isPath);
+
+  const auto addJunction = [this] (const Pos tile) {
+    if (path(tile) && degree(tile) != 2) {
+      seeds.push_back(makeNode(tile));
+    }
+  };
+  addJunction(pos);
+  for (const Dir dir : dir_range) {
+    addJunction(pos + toVec<Coord>(dir));
+  }
+
+  for (size_t s = 0; s != seeds.size(); ++s) {
+    if (nodes[seeds[s]].alive) {
+      trace(seeds[s]);
+    }
+  }
+  // tiles that weren't reached are on a loop without any junctions
+  for (const Pos tile : loose) {
+    if (path(tile) && slots[tile].index == none) {
+      trace(makeNode(tile));
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::CorridorGraph::update(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const Pos pos
+) {
+  setPath(pos, !notPath(grid[pos]));
+}
+
+inline void Grid::CorridorGraph::rebuild() {
+  nodes.clear();
+  edges.clear();
+  freeNodes.clear();
+  freeEdges.clear();
+  std::fill(slots.begin(), slots.end(), Slot{});
+
+  for (const Coord y : slots.vert()) {
+    for (const Coord x : slots.hori()) {
+      if (path({x, y}) && degree({x, y}) != 2) {
+        makeNode({x, y});
+      }
+    }
+  }
+  for (NodeID n = 0; n != nodes.size(); ++n) {
+    trace(n);
+  }
+  // tiles that weren't reached are on a loop without any junctions
+  for (const Coord y : slots.vert()) {
+    for (const Coord x : slots.hori()) {
+      if (path({x, y}) && slots(x, y).index == none) {
+        trace(makeNode({x, y}));
+      }
+    }
+  }
+}
+
+inline unsigned Grid::CorridorGraph::degree(const Pos pos) const {
+  unsigned count = 0;
+  for (const Dir dir : dir_range) {
+    count += path(pos + toVec<Coord>(dir));
+  }
+  return count;
+}
+
+inline Grid::Pos Grid::CorridorGraph::tileAt(const Edge &edge, const Coord offset) const {
+  if (offset == 0) {
+    return nodes[edge.a].pos;
+  } else if (offset == edge.length()) {
+    return nodes[edge.b].pos;
+  } else {
+    return edge.tiles[static_cast<size_t>(offset - 1)];
+  }
+}
+
+inline Grid::CorridorGraph::NodeID Grid::CorridorGraph::makeNode(const Pos pos) {
+  NodeID id;
+  if (freeNodes.empty()) {
+    id = static_cast<NodeID>(nodes.size());
+    nodes.emplace_back();
+  } else {
+    id = freeNodes.back();
+    freeNodes.pop_back();
+  }
+  Node &node = nodes[id];
+  node.pos = pos;
+  node.edges.fill(none);
+  node.alive = true;
+  slots[pos] = {none, id};
+  return id;
+}
+
+inline void Grid::CorridorGraph::trace(const NodeID start) {
+  for (const Dir startDir : dir_range) {
+    if (nodes[start].edges[+startDir] != none) {
+      continue;
+    }
+    Pos pos = nodes[start].pos + toVec<Coord>(startDir);
+    if (!path(pos)) {
+      continue;
+    }
+
+    EdgeID id;
+    if (freeEdges.empty()) {
+      id = static_cast<EdgeID>(edges.size());
+      edges.emplace_back();
+    } else {
+      id = freeEdges.back();
+      freeEdges.pop_back();
+    }
+    Edge &edge = edges[id];
+    edge.tiles.clear();
+
+    // follow the corridor until it reaches a junction
+    Dir dir = startDir;
+    while (!junction(pos)) {
+      assert(slots[pos].index == none);
+      edge.tiles.push_back(pos);
+      slots[pos] = {id, static_cast<uint32_t>(edge.tiles.size())};
+      for (const Dir next : dir_range) {
+        if (next != opposite(dir) && path(pos + toVec<Coord>(next))) {
+          dir = next;
+          break;
+        }
+      }
+      pos += toVec<Coord>(dir);
+    }
+
+    const NodeID end = slots[pos].index;
+    edge.a = start;
+    edge.b = end;
+    edge.dirA = startDir;
+    edge.dirB = opposite(dir);
+    assert(nodes[end].edges[+edge.dirB] == none);
+    nodes[start].edges[+startDir] = id;
+    nodes[end].edges[+edge.dirB] = id;
+  }
+}
+
+inline void Grid::CorridorGraph::removeEdge(const EdgeID id) {
+  Edge &edge = edges[id];
+  for (const Pos tile : edge.tiles) {
+    slots[tile] = {};
+    loose.push_back(tile);
+  }
+  edge.tiles.clear();
+  nodes[edge.a].edges[+edge.dirA] = none;
+  nodes[edge.b].edges[+edge.dirB] = none;
+  seeds.push_back(edge.a);
+  seeds.push_back(edge.b);
+  freeEdges.push_back(id);
+}
+
+inline void Grid::CorridorGraph::removeTile(const Pos pos) {
+  if (walls.outOfRange(pos)) {
+    return;
+  }
+  const Slot slot = slots[pos];
+  if (slot.edge != none) {
+    removeEdge(slot.edge);
+  } else if (slot.index != none) {
+    Node &node = nodes[slot.index];
+    for (const EdgeID edge : node.edges) {
+      if (edge != none) {
+        removeEdge(edge);
+      }
+    }
+    node.alive = false;
+    slots[pos] = {};
+    loose.push_back(pos);
+    freeNodes.push_back(slot.index);
+  }
+}
+
+inline Grid::AStarWorkspace::Index Grid::CorridorGraph::search(const Pos start, const Pos end) {
+  using Index = AStarWorkspace::Index;
+  if (!path(start) || !path(end)) {
+    return AStarWorkspace::none;
+  }
+
+  // junctions are searched directly. Ends that are on a corridor get their
+  // own index after the junctions
+  const Index numNodes = static_cast<Index>(nodes.size());
+  const Slot startSlot = slots[start];
+  const Slot endSlot = slots[end];
+  const Index startIndex = startSlot.edge == none ? startSlot.index : numNodes;
+  const Index endIndex = endSlot.edge == none ? endSlot.index : numNodes + 1;
+  const auto posOf = [&] (const Index index) {
+    return index == numNodes ? start : index == numNodes + 1 ? end : nodes[index].pos;
+  };
+
+  workspace.reset(numNodes + 2);
+  via.resize(numNodes + 2);
+  workspace.relax(endIndex, AStarWorkspace::none, 0, sumAxis(start, end));
+
+  // the corridors are searched backwards from the end so that following the
+  // parents from the start gives the path in order
+  const auto relax = [&] (
+    const Index index,
+    const Index parent,
+    const Coord cost,
+    const EdgeID edge,
+    const Coord offset,
+    const Coord parentOffset
+  ) {
+    const Coord pathCost = cost + std::abs(offset - parentOffset);
+    if (workspace.relax(index, parent, pathCost, pathCost + sumAxis(posOf(index), start))) {
+      via[index] = {edge, offset, parentOffset};
+    }
+  };
+  // move along a corridor in both directions from a point on it
+  const auto expand = [&] (const Index top, const Coord cost, const EdgeID id, const Coord offset) {
+    const Edge &edge = edges[id];
+    if (startSlot.edge == id) {
+      relax(startIndex, top, cost, id, static_cast<Coord>(startSlot.index), offset);
+    }
+    if (offset != 0) {
+      relax(edge.a, top, cost, id, 0, offset);
+    }
+    if (offset != edge.length()) {
+      relax(edge.b, top, cost, id, edge.length(), offset);
+    }
+  };
+
+  while (!workspace.empty()) {
+    const Index top = workspace.pop();
+    if (top == startIndex) {
+      return top;
+    }
+    const Coord cost = workspace.cost(top);
+    if (top == numNodes + 1) {
+      expand(top, cost, endSlot.edge, static_cast<Coord>(endSlot.index));
+      continue;
+    }
+    const Node &node = nodes[top];
+    for (const Dir dir : dir_range) {
+      const EdgeID id = node.edges[+dir];
+      if (id == none) {
+        continue;
+      }
+      const Edge &edge = edges[id];
+      // a loop leaves the same junction in two directions
+      const bool atA = edge.a == top && edge.dirA == dir;
+      expand(top, cost, id, atA ? 0 : edge.length());
+    }
+  }
+
+  // there is no path
+  return AStarWorkspace::none;
+}
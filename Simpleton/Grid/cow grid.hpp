@@ -0,0 +1,211 @@
+//
+//  cow grid.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_cow_grid_hpp
+#define engine_grid_cow_grid_hpp
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include "grid.hpp"
+#include "a star.hpp"
+
+namespace Grid {
+  namespace detail {
+    // A square chunk of tiles with a reference count. Chunks are shared
+    // between a CowGrid and its snapshots
+    template <typename Tile, Coord ChunkSize>
+    struct CowChunk {
+      std::atomic<uint32_t> refs{1};
+      std::array<Tile, static_cast<size_t>(ChunkSize * ChunkSize)> tiles;
+    };
+
+    // An owning reference to a chunk
+    template <typename Tile, Coord ChunkSize>
+    class CowChunkRef {
+    public:
+      using Chunk = CowChunk<Tile, ChunkSize>;
+
+      CowChunkRef() = default;
+      explicit CowChunkRef(Chunk *);
+      CowChunkRef(const CowChunkRef &);
+      CowChunkRef(CowChunkRef &&) noexcept;
+      CowChunkRef &operator=(CowChunkRef);
+      ~CowChunkRef();
+
+      Chunk *get() const {
+        return chunk;
+      }
+      // is this the only reference to the chunk?
+      bool unique() const;
+
+    private:
+      Chunk *chunk = nullptr;
+    };
+
+    // The chunks and the read-only interface shared by CowGrid and
+    // GridSnapshot. Indicies are row-major like a Grid
+    template <typename Tile_, Coord ChunkSize_>
+    class CowBase {
+    public:
+      using Tile = Tile_;
+      static constexpr Coord chunk_size = ChunkSize_;
+
+      static_assert(chunk_size > 0 && (chunk_size & (chunk_size - 1)) == 0, "Chunk size must be a power of 2");
+
+      Pos size() const {
+        return mSize;
+      }
+      Coord width() const {
+        return mSize.x;
+      }
+      Coord height() const {
+        return mSize.y;
+      }
+      size_t area() const {
+        return static_cast<size_t>(mSize.x) * static_cast<size_t>(mSize.y);
+      }
+      auto hori() const {
+        return Utils::range(mSize.x);
+      }
+      auto vert() const {
+        return Utils::range(mSize.y);
+      }
+
+      bool outOfRange(const Pos pos) const {
+        return pos.x < 0 || pos.y < 0 || pos.x >= mSize.x || pos.y >= mSize.y;
+      }
+      bool outOfRange(const size_t index) const {
+        return index >= area();
+      }
+      size_t toIndex(const Pos pos) const {
+        assert(!outOfRange(pos));
+        return static_cast<size_t>(pos.y) * static_cast<size_t>(mSize.x) + static_cast<size_t>(pos.x);
+      }
+      Pos toPos(const size_t index) const {
+        assert(!outOfRange(index));
+        const Coord cindex = static_cast<Coord>(index);
+        return {cindex % mSize.x, cindex / mSize.x};
+      }
+
+      const Tile &operator()(const Coord x, const Coord y) const {
+        return (*this)[Pos{x, y}];
+      }
+      const Tile &operator[](const Pos pos) const {
+        assert(!outOfRange(pos));
+        return chunks[chunkIndex(pos)].get()->tiles[tileIndex(pos)];
+      }
+      const Tile &operator[](const size_t index) const {
+        return (*this)[toPos(index)];
+      }
+      const Tile &at(Pos) const;
+
+      /// Number of chunks
+      size_t numChunks() const {
+        return chunks.size();
+      }
+
+    protected:
+      using Chunk = CowChunk<Tile, chunk_size>;
+      using ChunkRef = CowChunkRef<Tile, chunk_size>;
+
+      std::vector<ChunkRef> chunks;
+      Pos mSize = {0, 0};
+      Coord chunksX = 0;
+
+      size_t chunkIndex(const Pos pos) const {
+        return static_cast<size_t>((pos.y / chunk_size) * chunksX + pos.x / chunk_size);
+      }
+      static size_t tileIndex(const Pos pos) {
+        return static_cast<size_t>((pos.y & (chunk_size - 1)) * chunk_size + (pos.x & (chunk_size - 1)));
+      }
+    };
+  }
+
+  template <typename Tile, Coord ChunkSize>
+  class CowGrid;
+
+  /// A read-only view of a CowGrid at the time the snapshot was taken. The
+  /// snapshot shares chunks with the grid so it is cheap to take and it isn't
+  /// affected by writes to the grid. Snapshots can be read and copied on any
+  /// thread without locking.
+  template <typename Tile, Coord ChunkSize = 64>
+  class GridSnapshot final : public detail::CowBase<Tile, ChunkSize> {
+  public:
+    friend CowGrid<Tile, ChunkSize>;
+
+    GridSnapshot() = default;
+  };
+
+  /// A grid that can take cheap immutable snapshots for worker threads. Tiles
+  /// are stored in square chunks that have an atomic reference count. Taking
+  /// a snapshot shares every chunk with the snapshot. Writing to a chunk that
+  /// is shared copies the chunk first so the snapshot never changes. The grid
+  /// itself should only be used by one thread.
+  template <typename Tile, Coord ChunkSize = 64>
+  class CowGrid final : public detail::CowBase<Tile, ChunkSize> {
+  public:
+    using Snapshot = GridSnapshot<Tile, ChunkSize>;
+
+    CowGrid() = default;
+    /// Every chunk starts off sharing a single chunk so creating a grid only
+    /// allocates one chunk
+    CowGrid(Coord, Coord, const Tile & = {});
+    explicit CowGrid(Pos, const Tile & = {});
+    template <Coord Width, Coord Height, typename Layout>
+    explicit CowGrid(const Grid<Tile, Width, Height, Layout> &);
+
+    /// Set a tile. The chunk is copied if it's shared
+    void set(Pos, const Tile &);
+    /// Get a tile for writing. The chunk is copied if it's shared. The
+    /// reference is valid until the next snapshot is taken
+    Tile &edit(Pos);
+
+    /// Take a snapshot of the grid. This is proportional to the number of
+    /// chunks, not the number of tiles
+    Snapshot snapshot() const;
+
+    /// Number of chunks that are shared with a snapshot or with other parts of
+    /// the grid
+    size_t numShared() const;
+
+  private:
+    using typename detail::CowBase<Tile, ChunkSize>::Chunk;
+    using typename detail::CowBase<Tile, ChunkSize>::ChunkRef;
+    using detail::CowBase<Tile, ChunkSize>::chunk_size;
+    using detail::CowBase<Tile, ChunkSize>::chunks;
+    using detail::CowBase<Tile, ChunkSize>::mSize;
+    using detail::CowBase<Tile, ChunkSize>::chunksX;
+    using detail::CowBase<Tile, ChunkSize>::chunkIndex;
+    using detail::CowBase<Tile, ChunkSize>::tileIndex;
+
+    Chunk &writable(Pos);
+  };
+
+  /// The A* search algorithm on a snapshot. This is meant to be called on a
+  /// worker thread while the main thread keeps writing to the grid.
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord ChunkSize, typename Function
+  >
+  std::vector<Pos> astar(AStarWorkspace &, const GridSnapshot<Tile, ChunkSize> &, Function &&, Pos, Pos);
+
+  /// The A* search algorithm on a snapshot with a cost function
+  template <
+    typename Movement = FourWay,
+    typename Heuristic = typename Movement::Heuristic,
+    typename Tile, Coord ChunkSize, typename Function, typename CostFunction
+  >
+  std::vector<Pos> astar(AStarWorkspace &, const GridSnapshot<Tile, ChunkSize> &, Function &&, CostFunction &&, Pos, Pos);
+}
+
+#include "cow grid.inl"
+
+#endif
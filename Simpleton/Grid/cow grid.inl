@@ -0,0 +1,169 @@
+//
+//  cow grid.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::detail::CowChunkRef<Tile, ChunkSize>::CowChunkRef(Chunk *chunk)
+  : chunk{chunk} {}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::detail::CowChunkRef<Tile, ChunkSize>::CowChunkRef(const CowChunkRef &other)
+  : chunk{other.chunk} {
+  if (chunk) {
+    // a new reference can only be made from an existing one so nothing needs
+    // to be ordered here
+    chunk->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::detail::CowChunkRef<Tile, ChunkSize>::CowChunkRef(CowChunkRef &&other) noexcept
+  : chunk{std::exchange(other.chunk, nullptr)} {}
+
+template <typename Tile, Grid::Coord ChunkSize>
+auto Grid::detail::CowChunkRef<Tile, ChunkSize>::operator=(CowChunkRef other) -> CowChunkRef & {
+  std::swap(chunk, other.chunk);
+  return *this;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::detail::CowChunkRef<Tile, ChunkSize>::~CowChunkRef() {
+  // reads of the chunk on other threads must happen before it is deleted
+  if (chunk && chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete chunk;
+  }
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+bool Grid::detail::CowChunkRef<Tile, ChunkSize>::unique() const {
+  // if this is the only reference then no other thread can add one so the
+  // chunk can be written to. Acquire so that a snapshot that was just
+  // destroyed on another thread has finished reading
+  return chunk->refs.load(std::memory_order_acquire) == 1;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+const Tile &Grid::detail::CowBase<Tile, ChunkSize>::at(const Pos pos) const {
+  if (outOfRange(pos)) {
+    throw std::range_error("Position out of range");
+  }
+  return (*this)[pos];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::CowGrid<Tile, ChunkSize>::CowGrid(const Coord width, const Coord height, const Tile &tile)
+  : CowGrid{Pos{width, height}, tile} {}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Grid::CowGrid<Tile, ChunkSize>::CowGrid(const Pos size, const Tile &tile) {
+  assert(size.x >= 0 && size.y >= 0);
+  mSize = size;
+  chunksX = (size.x + chunk_size - 1) / chunk_size;
+  const Coord chunksY = (size.y + chunk_size - 1) / chunk_size;
+  if (chunksX == 0 || chunksY == 0) {
+    return;
+  }
+  ChunkRef fill{new Chunk};
+  fill.get()->tiles.fill(tile);
+  chunks.assign(static_cast<size_t>(chunksX * chunksY), fill);
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+template <Grid::Coord Width, Grid::Coord Height, typename Layout>
+Grid::CowGrid<Tile, ChunkSize>::CowGrid(const Grid<Tile, Width, Height, Layout> &grid) {
+  mSize = grid.size();
+  chunksX = (mSize.x + chunk_size - 1) / chunk_size;
+  const Coord chunksY = (mSize.y + chunk_size - 1) / chunk_size;
+  chunks.reserve(static_cast<size_t>(chunksX * chunksY));
+  for (Coord cy = 0; cy != chunksY; ++cy) {
+    for (Coord cx = 0; cx != chunksX; ++cx) {
+      ChunkRef &ref = chunks.emplace_back(new Chunk);
+      const Pos first = {cx * chunk_size, cy * chunk_size};
+      const Pos last = {
+        std::min(first.x + chunk_size, mSize.x),
+        std::min(first.y + chunk_size, mSize.y)
+      };
+      for (Coord y = first.y; y != last.y; ++y) {
+        for (Coord x = first.x; x != last.x; ++x) {
+          ref.get()->tiles[tileIndex({x, y})] = grid(x, y);
+        }
+      }
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+void Grid::CowGrid<Tile, ChunkSize>::set(const Pos pos, const Tile &tile) {
+  writable(pos).tiles[tileIndex(pos)] = tile;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+Tile &Grid::CowGrid<Tile, ChunkSize>::edit(const Pos pos) {
+  return writable(pos).tiles[tileIndex(pos)];
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+auto Grid::CowGrid<Tile, ChunkSize>::snapshot() const -> Snapshot {
+  Snapshot snap;
+  snap.chunks = chunks;
+  snap.mSize = mSize;
+  snap.chunksX = chunksX;
+  return snap;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+size_t Grid::CowGrid<Tile, ChunkSize>::numShared() const {
+  size_t count = 0;
+  for (const ChunkRef &ref : chunks) {
+    count += !ref.unique();
+  }
+  return count;
+}
+
+template <typename Tile, Grid::Coord ChunkSize>
+auto Grid::CowGrid<Tile, ChunkSize>::writable(const Pos pos) -> Chunk & {
+  assert(!this->outOfRange(pos));
+  ChunkRef &ref = chunks[chunkIndex(pos)];
+  if (!ref.unique()) {
+    Chunk *const copy = new Chunk;
+    copy->tiles = ref.get()->tiles;
+    ref = ChunkRef{copy};
+  }
+  return *ref.get();
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord ChunkSize, typename Function
+>
+std::vector<Grid::Pos> Grid::astar(
+  AStarWorkspace &workspace,
+  const GridSnapshot<Tile, ChunkSize> &grid,
+  Function &&notPath,
+  const Pos start,
+  const Pos end
+) {
+  UnitCost tileCost;
+  return detail::astar<Movement, Heuristic>(workspace, grid, notPath, tileCost, start, end);
+}
+
+template <
+  typename Movement,
+  typename Heuristic,
+  typename Tile, Grid::Coord ChunkSize, typename Function, typename CostFunction
+>
+std::vector<Grid::Pos> Grid::astar(
+  AStarWorkspace &workspace,
+  const GridSnapshot<Tile, ChunkSize> &grid,
+  Function &&notPath,
+  CostFunction &&tileCost,
+  const Pos start,
+  const Pos end
+) {
+  return detail::astar<Movement, Heuristic>(workspace, grid, notPath, tileCost, start, end);
+}
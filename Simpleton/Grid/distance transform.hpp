@@ -0,0 +1,79 @@
+//
+//  distance transform.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_distance_transform_hpp
+#define engine_grid_distance_transform_hpp
+
+#include "grid.hpp"
+#include "../Math/round.hpp"
+#include "../Utils/parallel for.hpp"
+
+namespace Grid {
+  /// Find the straight line distance (euclid) from every tile to the nearest
+  /// tile that is not path. Tiles that are not path are 0. Every tile is
+  /// infinitely far away if all of the tiles are path. The distance is exact
+  /// and takes linear time (Meijster's algorithm).
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<float, Width, Height, Layout> euclidTransform(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&
+  );
+
+  /// Find the straight line distance from every tile to the nearest tile that
+  /// is not path using multiple threads. Columns are processed in parallel
+  /// and then rows are processed in parallel.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<float, Width, Height, Layout> euclidTransform(
+    Utils::parallel_t,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    unsigned = 0
+  );
+
+  /// Find the manhattan distance (sumAxis) from every tile to the nearest tile
+  /// that is not path. Every tile is the max Coord if all of the tiles are
+  /// path.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Coord, Width, Height, Layout> sumAxisTransform(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&
+  );
+
+  /// Find the manhattan distance from every tile to the nearest tile that is
+  /// not path using multiple threads.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Coord, Width, Height, Layout> sumAxisTransform(
+    Utils::parallel_t,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    unsigned = 0
+  );
+
+  /// Find the chebyshev distance (maxAxis) from every tile to the nearest tile
+  /// that is not path. Every tile is the max Coord if all of the tiles are
+  /// path.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Coord, Width, Height, Layout> maxAxisTransform(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&
+  );
+
+  /// Find the chebyshev distance from every tile to the nearest tile that is
+  /// not path using multiple threads.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Coord, Width, Height, Layout> maxAxisTransform(
+    Utils::parallel_t,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    unsigned = 0
+  );
+}
+
+#include "distance transform.inl"
+
+#endif
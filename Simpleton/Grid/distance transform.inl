@@ -0,0 +1,277 @@
+//
+//  distance transform.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace Grid::detail {
+  // columns per task in the column pass and rows per task in the row pass
+  constexpr Coord transform_band = 64;
+
+  using TransformInt = int64_t;
+
+  // Each metric defines the distance from x to the nearest tile in column i
+  // given g (the vertical distance to the nearest tile in column i) and the
+  // last x where column i is closer than column u.
+
+  struct EuclidMetric {
+    using Dist = float;
+
+    static Dist far() {
+      return std::numeric_limits<float>::infinity();
+    }
+    static Dist finish(const TransformInt dist) {
+      return std::sqrt(static_cast<float>(dist));
+    }
+    static TransformInt dist(const TransformInt x, const TransformInt i, const TransformInt g) {
+      return (x - i) * (x - i) + g * g;
+    }
+    static TransformInt sep(
+      const TransformInt i,
+      const TransformInt u,
+      const TransformInt gi,
+      const TransformInt gu
+    ) {
+      return Math::divFloor(u * u - i * i + gu * gu - gi * gi, 2 * (u - i));
+    }
+  };
+
+  struct SumAxisMetric {
+    using Dist = Coord;
+
+    static Dist far() {
+      return std::numeric_limits<Coord>::max();
+    }
+    static Dist finish(const TransformInt dist) {
+      return static_cast<Coord>(dist);
+    }
+    static TransformInt dist(const TransformInt x, const TransformInt i, const TransformInt g) {
+      return std::abs(x - i) + g;
+    }
+    static TransformInt sep(
+      const TransformInt i,
+      const TransformInt u,
+      const TransformInt gi,
+      const TransformInt gu
+    ) {
+      if (gu >= gi + u - i) {
+        return std::numeric_limits<TransformInt>::max() / 2;
+      }
+      if (gi > gu + u - i) {
+        return std::numeric_limits<TransformInt>::min() / 2;
+      }
+      return Math::divFloor(gu - gi + u + i, 2);
+    }
+  };
+
+  struct MaxAxisMetric {
+    using Dist = Coord;
+
+    static Dist far() {
+      return std::numeric_limits<Coord>::max();
+    }
+    static Dist finish(const TransformInt dist) {
+      return static_cast<Coord>(dist);
+    }
+    static TransformInt dist(const TransformInt x, const TransformInt i, const TransformInt g) {
+      return std::max(std::abs(x - i), g);
+    }
+    static TransformInt sep(
+      const TransformInt i,
+      const TransformInt u,
+      const TransformInt gi,
+      const TransformInt gu
+    ) {
+      if (gi <= gu) {
+        return std::max(i + gu, Math::divFloor(i + u, 2));
+      } else {
+        return std::min(u - gi, Math::divFloor(i + u, 2));
+      }
+    }
+  };
+
+  // Find the vertical distance to the nearest tile that is not path for a
+  // range of columns. The columns are swept together a row at a time so that
+  // memory is accessed in order.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  void transformColumns(
+    const Grid<Tile, Width, Height, Layout> &grid,
+    Function &notPath,
+    Grid<Coord, Width, Height, Layout> &vert,
+    const Coord far,
+    const Coord beginX,
+    const Coord endX
+  ) {
+    for (Coord x = beginX; x != endX; ++x) {
+      vert(x, 0) = notPath(grid(x, 0)) ? 0 : far;
+    }
+    for (Coord y = 1; y < grid.height(); ++y) {
+      for (Coord x = beginX; x != endX; ++x) {
+        vert(x, y) = notPath(grid(x, y)) ? 0 : std::min(vert(x, y - 1) + 1, far);
+      }
+    }
+    for (Coord y = grid.height() - 2; y >= 0; --y) {
+      for (Coord x = beginX; x != endX; ++x) {
+        vert(x, y) = std::min(vert(x, y), vert(x, y + 1) + 1);
+      }
+    }
+  }
+
+  // Buffers for transforming a row
+  struct TransformRow {
+    std::vector<TransformInt> vert;
+    // the column that is nearest in each segment of the row
+    std::vector<TransformInt> column;
+    // the first x of each segment of the row
+    std::vector<TransformInt> start;
+
+    explicit TransformRow(const size_t width)
+      : vert(width), column(width), start(width) {}
+  };
+
+  // Combine the vertical distances of a row into the final distances
+  template <typename Metric, typename Dist, Coord Width, Coord Height, typename Layout>
+  void transformRow(
+    const Grid<Coord, Width, Height, Layout> &vert,
+    Grid<Dist, Width, Height, Layout> &dist,
+    TransformRow &row,
+    const Coord far,
+    const Coord y
+  ) {
+    const TransformInt width = vert.width();
+    bool anyNear = false;
+    for (const Coord x : vert.hori()) {
+      const Coord g = vert(x, y);
+      row.vert[static_cast<size_t>(x)] = g;
+      anyNear |= g != far;
+    }
+    // if none of the columns in this row have a tile that isn't path then
+    // none of the columns do
+    if (!anyNear) {
+      for (const Coord x : vert.hori()) {
+        dist(x, y) = Metric::far();
+      }
+      return;
+    }
+
+    const TransformInt *g = row.vert.data();
+    TransformInt *column = row.column.data();
+    TransformInt *start = row.start.data();
+    std::ptrdiff_t q = 0;
+    column[0] = 0;
+    start[0] = 0;
+    for (TransformInt u = 1; u < width; ++u) {
+      while (q >= 0 && Metric::dist(start[q], column[q], g[column[q]]) > Metric::dist(start[q], u, g[u])) {
+        --q;
+      }
+      if (q < 0) {
+        q = 0;
+        column[0] = u;
+      } else {
+        const TransformInt w = 1 + Metric::sep(column[q], u, g[column[q]], g[u]);
+        if (w < width) {
+          ++q;
+          column[q] = u;
+          start[q] = w;
+        }
+      }
+    }
+    for (TransformInt u = width - 1; u >= 0; --u) {
+      dist(static_cast<Coord>(u), y) = Metric::finish(Metric::dist(u, column[q], g[column[q]]));
+      if (u == start[q]) {
+        --q;
+      }
+    }
+  }
+
+  template <typename Metric, typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<typename Metric::Dist, Width, Height, Layout> distanceTransform(
+    const Grid<Tile, Width, Height, Layout> &grid,
+    Function &notPath,
+    const unsigned threads
+  ) {
+    // further than any tile in the grid
+    const Coord far = grid.width() + grid.height();
+    Grid<Coord, Width, Height, Layout> vert{grid.size()};
+    Grid<typename Metric::Dist, Width, Height, Layout> dist{grid.size()};
+
+    const size_t columnBands = static_cast<size_t>((grid.width() + transform_band - 1) / transform_band);
+    Utils::parallelFor(0, columnBands, [&] (const size_t band) {
+      const Coord beginX = static_cast<Coord>(band) * transform_band;
+      const Coord endX = std::min(beginX + transform_band, grid.width());
+      transformColumns(grid, notPath, vert, far, beginX, endX);
+    }, threads);
+
+    const size_t rowBands = static_cast<size_t>((grid.height() + transform_band - 1) / transform_band);
+    Utils::parallelFor(0, rowBands, [&] (const size_t band) {
+      TransformRow row{static_cast<size_t>(grid.width())};
+      const Coord beginY = static_cast<Coord>(band) * transform_band;
+      const Coord endY = std::min(beginY + transform_band, grid.height());
+      for (Coord y = beginY; y != endY; ++y) {
+        transformRow<Metric>(vert, dist, row, far, y);
+      }
+    }, threads);
+
+    return dist;
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<float, Width, Height, Layout> Grid::euclidTransform(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath
+) {
+  return detail::distanceTransform<detail::EuclidMetric>(grid, notPath, 1);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<float, Width, Height, Layout> Grid::euclidTransform(
+  Utils::parallel_t,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const unsigned threads
+) {
+  return detail::distanceTransform<detail::EuclidMetric>(grid, notPath, threads);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Coord, Width, Height, Layout> Grid::sumAxisTransform(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath
+) {
+  return detail::distanceTransform<detail::SumAxisMetric>(grid, notPath, 1);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Coord, Width, Height, Layout> Grid::sumAxisTransform(
+  Utils::parallel_t,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const unsigned threads
+) {
+  return detail::distanceTransform<detail::SumAxisMetric>(grid, notPath, threads);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Coord, Width, Height, Layout> Grid::maxAxisTransform(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath
+) {
+  return detail::distanceTransform<detail::MaxAxisMetric>(grid, notPath, 1);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Coord, Width, Height, Layout> Grid::maxAxisTransform(
+  Utils::parallel_t,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const unsigned threads
+) {
+  return detail::distanceTransform<detail::MaxAxisMetric>(grid, notPath, threads);
+}
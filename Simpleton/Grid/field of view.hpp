@@ -0,0 +1,87 @@
+//
+//  field of view.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_field_of_view_hpp
+#define engine_grid_field_of_view_hpp
+
+#include "grid.hpp"
+#include "bit grid.hpp"
+#include "../Math/round.hpp"
+#include "../Utils/parallel for.hpp"
+
+namespace Grid {
+  /// A position that can see tiles up to a distance away
+  struct Viewer {
+    Pos pos;
+    Coord radius;
+  };
+
+  /// Set the bits of the tiles that can be seen from the origin. Bits that
+  /// are already set are left alone so that the views of several viewers can
+  /// be merged. This uses symmetric shadowcasting so if A can see B then B can
+  /// see A. Each visible tile is visited once so this is proportional to the
+  /// area of the view rather than the area times the radius. Opaque tiles can
+  /// be seen but they block the tiles behind them. A tile is within the radius
+  /// if its euclidian distance from the origin is no more than the radius. The
+  /// bit grid must be the same size as the grid.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  void fov(BitGrid &, const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Coord);
+
+  /// Find the tiles that can be seen from the origin
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  BitGrid fov(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Coord);
+
+  /// Set the bits of the tiles that can be seen from the origin. Set bits of
+  /// the opaque grid block vision
+  void fov(BitGrid &, const BitGrid &, Pos, Coord);
+
+  /// Find the tiles that can be seen from the origin. Set bits of the opaque
+  /// grid block vision
+  BitGrid fov(const BitGrid &, Pos, Coord);
+
+  /// Find the tiles that can be seen by any of the viewers
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  BitGrid fov(const Grid<Tile, Width, Height, Layout> &, Function &&, const std::vector<Viewer> &);
+
+  /// Find the tiles that can be seen by any of the viewers using multiple
+  /// threads. Each thread finds the view of some of the viewers and the views
+  /// are merged a word at a time. The opaque predicate is called from multiple
+  /// threads at the same time so it must not modify anything.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  BitGrid fov(
+    Utils::parallel_t,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    const std::vector<Viewer> &,
+    unsigned = 0
+  );
+
+  /// Find the tiles that can be seen by any of the viewers. Set bits of the
+  /// opaque grid block vision
+  BitGrid fov(const BitGrid &, const std::vector<Viewer> &);
+
+  /// Find the tiles that can be seen by any of the viewers using multiple
+  /// threads. Set bits of the opaque grid block vision
+  BitGrid fov(Utils::parallel_t, const BitGrid &, const std::vector<Viewer> &, unsigned = 0);
+
+  /// Check whether there is a clear line between the centres of two tiles.
+  /// The tiles along a Bresenham line between them (not including the ends)
+  /// must not be opaque. This is cheaper than fov when only a few pairs of
+  /// tiles need to be checked. It is symmetric but it doesn't always agree
+  /// with fov near the corners of opaque tiles.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  bool lineOfSight(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Pos);
+
+  /// Check whether there is a clear line between the centres of two tiles.
+  /// Set bits of the opaque grid block vision
+  bool lineOfSight(const BitGrid &, Pos, Pos);
+}
+
+#include "field of view.inl"
+
+#endif
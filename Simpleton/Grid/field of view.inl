@@ -0,0 +1,263 @@
+//
+//  field of view.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+namespace Grid::detail {
+  // a row of tiles in a quadrant. The slopes are fractions and the
+  // denominators are always positive
+  struct FovRow {
+    Coord depth;
+    Coord startNum, startDen;
+    Coord endNum, endDen;
+  };
+
+  // Symmetric shadowcasting over one quadrant. Rows are processed from a
+  // stack rather than recursively. The tile at (depth, col) is
+  // origin + forward*depth + side*col
+  template <typename GridType, typename Function>
+  void fovQuadrant(
+    BitGrid &visible,
+    const GridType &grid,
+    Function &opaque,
+    const Pos origin,
+    const Coord radius,
+    const Pos forward,
+    const Pos side,
+    std::vector<FovRow> &rows
+  ) {
+    const Coord radius2 = radius * radius;
+    rows.clear();
+    rows.push_back({1, -1, 1, 1, 1});
+
+    while (!rows.empty()) {
+      FovRow row = rows.back();
+      rows.pop_back();
+      const Coord depth = row.depth;
+      // round half up and round half down
+      const Coord minCol = Math::divFloor(2 * depth * row.startNum + row.startDen, 2 * row.startDen);
+      const Coord maxCol = Math::divCeil(2 * depth * row.endNum - row.endDen, 2 * row.endDen);
+
+      enum { unseen, clear, blocked } prev = unseen;
+      for (Coord col = minCol; col <= maxCol; ++col) {
+        const Pos pos = {
+          origin.x + forward.x * depth + side.x * col,
+          origin.y + forward.y * depth + side.y * col
+        };
+        const bool inRange = !grid.outOfRange(pos);
+        const bool isWall = !inRange || opaque(grid[pos]);
+
+        if (inRange && col * col + depth * depth <= radius2) {
+          // floor tiles are only visible if their centre is within the
+          // shadow-free area. This is what makes the result symmetric
+          if (isWall || (
+            col * row.startDen >= depth * row.startNum &&
+            col * row.endDen <= depth * row.endNum
+          )) {
+            visible.set(pos);
+          }
+        }
+
+        if (prev == blocked && !isWall) {
+          row.startNum = 2 * col - 1;
+          row.startDen = 2 * depth;
+        }
+        if (prev == clear && isWall && depth < radius) {
+          rows.push_back({depth + 1, row.startNum, row.startDen, 2 * col - 1, 2 * depth});
+        }
+        prev = isWall ? blocked : clear;
+      }
+
+      if (prev == clear && depth < radius) {
+        rows.push_back({depth + 1, row.startNum, row.startDen, row.endNum, row.endDen});
+      }
+    }
+  }
+
+  template <typename GridType, typename Function>
+  void fov(
+    BitGrid &visible,
+    const GridType &grid,
+    Function &opaque,
+    const Pos origin,
+    const Coord radius,
+    std::vector<FovRow> &rows
+  ) {
+    assert(visible.size() == grid.size());
+    if (grid.outOfRange(origin) || radius < 0) {
+      return;
+    }
+    visible.set(origin);
+    fovQuadrant(visible, grid, opaque, origin, radius, {0, 1}, {1, 0}, rows);
+    fovQuadrant(visible, grid, opaque, origin, radius, {1, 0}, {0, 1}, rows);
+    fovQuadrant(visible, grid, opaque, origin, radius, {0, -1}, {1, 0}, rows);
+    fovQuadrant(visible, grid, opaque, origin, radius, {-1, 0}, {0, 1}, rows);
+  }
+
+  template <typename GridType, typename Function>
+  BitGrid fov(const GridType &grid, Function &opaque, const std::vector<Viewer> &viewers) {
+    BitGrid visible{grid.size()};
+    std::vector<FovRow> rows;
+    for (const Viewer &viewer : viewers) {
+      detail::fov(visible, grid, opaque, viewer.pos, viewer.radius, rows);
+    }
+    return visible;
+  }
+
+  template <typename GridType, typename Function>
+  BitGrid fov(
+    Utils::parallel_t,
+    const GridType &grid,
+    Function &opaque,
+    const std::vector<Viewer> &viewers,
+    const unsigned threads
+  ) {
+    const size_t count = std::min(static_cast<size_t>(Utils::numThreads(threads)), viewers.size());
+    if (count <= 1) {
+      return detail::fov(grid, opaque, viewers);
+    }
+
+    // each thread writes to its own bit grid so they don't touch the same
+    // words
+    std::vector<BitGrid> views(count, BitGrid{grid.size()});
+    Utils::parallelFor(0, count, [&] (const size_t t) {
+      std::vector<FovRow> rows;
+      const size_t begin = viewers.size() * t / count;
+      const size_t end = viewers.size() * (t + 1) / count;
+      for (size_t v = begin; v != end; ++v) {
+        detail::fov(views[t], grid, opaque, viewers[v].pos, viewers[v].radius, rows);
+      }
+    }, static_cast<unsigned>(count));
+
+    BitGrid visible = std::move(views[0]);
+    for (size_t t = 1; t != count; ++t) {
+      visible |= views[t];
+    }
+    return visible;
+  }
+
+  template <typename GridType, typename Function>
+  bool lineOfSight(const GridType &grid, Function &opaque, Pos a, Pos b) {
+    if (grid.outOfRange(a) || grid.outOfRange(b)) {
+      return false;
+    }
+    if (a == b) {
+      return true;
+    }
+    // always walk in the same direction so that the result is symmetric
+    if (b.x < a.x || (b.x == a.x && b.y < a.y)) {
+      std::swap(a, b);
+    }
+    const Coord dx = std::abs(b.x - a.x);
+    const Coord dy = -std::abs(b.y - a.y);
+    const Coord sy = a.y < b.y ? 1 : -1;
+    Coord error = dx + dy;
+    Pos pos = a;
+    while (true) {
+      const Coord error2 = 2 * error;
+      if (error2 >= dy) {
+        error += dy;
+        ++pos.x;
+      }
+      if (error2 <= dx) {
+        error += dx;
+        pos.y += sy;
+      }
+      if (pos == b) {
+        return true;
+      }
+      if (opaque(grid[pos])) {
+        return false;
+      }
+    }
+  }
+
+  inline bool bitOpaque(const bool bit) {
+    return bit;
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::fov(
+  BitGrid &visible,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&opaque,
+  const Pos origin,
+  const Coord radius
+) {
+  std::vector<detail::FovRow> rows;
+  detail::fov(visible, grid, opaque, origin, radius, rows);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::BitGrid Grid::fov(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&opaque,
+  const Pos origin,
+  const Coord radius
+) {
+  BitGrid visible{grid.size()};
+  fov(visible, grid, opaque, origin, radius);
+  return visible;
+}
+
+inline void Grid::fov(BitGrid &visible, const BitGrid &opaque, const Pos origin, const Coord radius) {
+  std::vector<detail::FovRow> rows;
+  detail::fov(visible, opaque, detail::bitOpaque, origin, radius, rows);
+}
+
+inline Grid::BitGrid Grid::fov(const BitGrid &opaque, const Pos origin, const Coord radius) {
+  BitGrid visible{opaque.size()};
+  fov(visible, opaque, origin, radius);
+  return visible;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::BitGrid Grid::fov(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&opaque,
+  const std::vector<Viewer> &viewers
+) {
+  return detail::fov(grid, opaque, viewers);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::BitGrid Grid::fov(
+  Utils::parallel_t,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&opaque,
+  const std::vector<Viewer> &viewers,
+  const unsigned threads
+) {
+  return detail::fov(Utils::parallel, grid, opaque, viewers, threads);
+}
+
+inline Grid::BitGrid Grid::fov(const BitGrid &opaque, const std::vector<Viewer> &viewers) {
+  return detail::fov(opaque, detail::bitOpaque, viewers);
+}
+
+inline Grid::BitGrid Grid::fov(
+  Utils::parallel_t,
+  const BitGrid &opaque,
+  const std::vector<Viewer> &viewers,
+  const unsigned threads
+) {
+  return detail::fov(Utils::parallel, opaque, detail::bitOpaque, viewers, threads);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+bool Grid::lineOfSight(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&opaque,
+  const Pos a,
+  const Pos b
+) {
+  return detail::lineOfSight(grid, opaque, a, b);
+}
+
+inline bool Grid::lineOfSight(const BitGrid &opaque, const Pos a, const Pos b) {
+  return detail::lineOfSight(opaque, detail::bitOpaque, a, b);
+}
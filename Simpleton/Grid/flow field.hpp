@@ -0,0 +1,83 @@
+//
+//  flow field.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_flow_field_hpp
+#define engine_grid_flow_field_hpp
+
+#include "dir.hpp"
+#include "grid.hpp"
+#include "../Utils/parallel for.hpp"
+
+namespace Grid {
+  /// The distance to tiles that can't reach a goal
+  constexpr Coord unreachable = -1;
+
+  /// Find the distance (in tiles) from every tile to the nearest goal with a
+  /// single breadth-first search (a Dijkstra map). Tiles that can't reach a
+  /// goal are unreachable. Like the end of astar, goals don't need to be path
+  /// tiles.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Coord, Width, Height, Layout> distanceField(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    const std::vector<Pos> &
+  );
+
+  /// Find the distance from every tile to the nearest goal using multiple
+  /// threads. The grid is split into blocks and the blocks are relaxed in
+  /// parallel until they agree with each other. The result is the same as the
+  /// single threaded version. Relaxing the blocks takes about twice as much
+  /// work as a single breadth-first search so this needs a few cores to be
+  /// faster.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Coord, Width, Height, Layout> distanceField(
+    Utils::parallel_t,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    const std::vector<Pos> &,
+    unsigned = 0
+  );
+
+  /// Find the direction to move from every tile to get closer to the nearest
+  /// goal. Goals and unreachable tiles are Dir::none.
+  template <Coord Width, Coord Height, typename Layout>
+  Grid<Dir, Width, Height, Layout> flowField(const Grid<Coord, Width, Height, Layout> &);
+
+  /// Find the direction to move from every tile to get closer to the nearest
+  /// goal using multiple threads.
+  template <Coord Width, Coord Height, typename Layout>
+  Grid<Dir, Width, Height, Layout> flowField(
+    Utils::parallel_t,
+    const Grid<Coord, Width, Height, Layout> &,
+    unsigned = 0
+  );
+
+  /// Find the direction to move from every tile to get closer to the nearest
+  /// goal. Agents can look up their next step in constant time.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Dir, Width, Height, Layout> flowField(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    const std::vector<Pos> &
+  );
+
+  /// Find the direction to move from every tile to get closer to the nearest
+  /// goal using multiple threads.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<Dir, Width, Height, Layout> flowField(
+    Utils::parallel_t,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    const std::vector<Pos> &,
+    unsigned = 0
+  );
+}
+
+#include "flow field.inl"
+
+#endif
@@ -0,0 +1,257 @@
+//
+//  flow field.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <limits>
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Coord, Width, Height, Layout> Grid::distanceField(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const std::vector<Pos> &goals
+) {
+  Grid<Coord, Width, Height, Layout> dist{grid.size(), unreachable};
+  std::vector<Pos> queue;
+  queue.reserve(grid.area());
+
+  for (const Pos goal : goals) {
+    assert(!grid.outOfRange(goal));
+    Coord &goalDist = dist[goal];
+    if (goalDist != 0) {
+      goalDist = 0;
+      queue.push_back(goal);
+    }
+  }
+
+  for (size_t q = 0; q != queue.size(); ++q) {
+    const Pos pos = queue[q];
+    const Coord neighDist = dist[pos] + 1;
+    for (const Dir dir : dir_range) {
+      const Pos neighPos = pos + toVec<Coord>(dir);
+      if (grid.outOfRange(neighPos)) {
+        continue;
+      }
+      Coord &neighDistRef = dist[neighPos];
+      if (neighDistRef != unreachable || notPath(grid[neighPos])) {
+        continue;
+      }
+      neighDistRef = neighDist;
+      queue.push_back(neighPos);
+    }
+  }
+
+  return dist;
+}
+
+namespace Grid::detail {
+  constexpr Coord flow_block_size = 64;
+  constexpr Coord far_away = std::numeric_limits<Coord>::max();
+
+  // Lower the distances in a block using the distances in the neighboring
+  // blocks. Returns true if any distance changed
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  bool relaxBlock(
+    const Grid<Tile, Width, Height, Layout> &grid,
+    Function &notPath,
+    Grid<Coord, Width, Height, Layout> &dist,
+    const Pos min,
+    const Pos max,
+    const bool first
+  ) {
+    thread_local std::vector<Pos> queue;
+    queue.clear();
+    bool changed = false;
+
+    if (first) {
+      // the goals in this block
+      for (Coord y = min.y; y != max.y; ++y) {
+        for (Coord x = min.x; x != max.x; ++x) {
+          if (dist(x, y) != far_away) {
+            queue.push_back({x, y});
+          }
+        }
+      }
+    }
+
+    const auto pull = [&] (const Pos pos, const Pos outside) {
+      if (grid.outOfRange(outside)) {
+        return;
+      }
+      const Coord outsideDist = dist[outside];
+      Coord &insideDist = dist[pos];
+      if (outsideDist != far_away && outsideDist + 1 < insideDist && !notPath(grid[pos])) {
+        insideDist = outsideDist + 1;
+        queue.push_back(pos);
+        changed = true;
+      }
+    };
+    for (Coord x = min.x; x != max.x; ++x) {
+      pull({x, min.y}, {x, min.y - 1});
+      pull({x, max.y - 1}, {x, max.y});
+    }
+    for (Coord y = min.y; y != max.y; ++y) {
+      pull({min.x, y}, {min.x - 1, y});
+      pull({max.x - 1, y}, {max.x, y});
+    }
+
+    // the seeds have different distances so tiles may be lowered more than
+    // once. This is still cheap because blocks are small
+    for (size_t q = 0; q != queue.size(); ++q) {
+      const Pos pos = queue[q];
+      const Coord neighDist = dist[pos] + 1;
+      for (const Dir dir : dir_range) {
+        const Pos neighPos = pos + toVec<Coord>(dir);
+        if (
+          neighPos.x < min.x || neighPos.y < min.y ||
+          neighPos.x >= max.x || neighPos.y >= max.y
+        ) {
+          continue;
+        }
+        Coord &neighDistRef = dist[neighPos];
+        if (neighDist < neighDistRef && !notPath(grid[neighPos])) {
+          neighDistRef = neighDist;
+          queue.push_back(neighPos);
+          changed = true;
+        }
+      }
+    }
+
+    return changed;
+  }
+
+  template <Coord Width, Coord Height, typename Layout>
+  Dir flowDir(const Grid<Coord, Width, Height, Layout> &dist, const Pos pos) {
+    Coord bestDist = dist[pos];
+    if (bestDist == unreachable || bestDist == 0) {
+      return Dir::none;
+    }
+    Dir bestDir = Dir::none;
+    for (const Dir dir : dir_range) {
+      const Pos neighPos = pos + toVec<Coord>(dir);
+      if (dist.outOfRange(neighPos)) {
+        continue;
+      }
+      const Coord neighDist = dist[neighPos];
+      if (neighDist != unreachable && neighDist < bestDist) {
+        bestDist = neighDist;
+        bestDir = dir;
+      }
+    }
+    return bestDir;
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Coord, Width, Height, Layout> Grid::distanceField(
+  Utils::parallel_t,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const std::vector<Pos> &goals,
+  const unsigned threads
+) {
+  Grid<Coord, Width, Height, Layout> dist{grid.size(), detail::far_away};
+  for (const Pos goal : goals) {
+    assert(!grid.outOfRange(goal));
+    dist[goal] = 0;
+  }
+
+  // Blocks are colored like a checkerboard. Blocks of the same color don't
+  // touch so they can be relaxed at the same time
+  constexpr Coord blockSize = detail::flow_block_size;
+  const Pos numBlocks = {
+    (grid.width() + blockSize - 1) / blockSize,
+    (grid.height() + blockSize - 1) / blockSize
+  };
+  std::vector<Pos> colors[2];
+  for (Coord y = 0; y != numBlocks.y; ++y) {
+    for (Coord x = 0; x != numBlocks.x; ++x) {
+      colors[(x + y) & 1].push_back({x, y});
+    }
+  }
+
+  bool first = true;
+  std::atomic<bool> changed;
+  do {
+    changed.store(false, std::memory_order_relaxed);
+    for (const std::vector<Pos> &blocks : colors) {
+      Utils::parallelFor(0, blocks.size(), [&] (const size_t b) {
+        const Pos min = blocks[b] * blockSize;
+        const Pos max = {
+          std::min(min.x + blockSize, grid.width()),
+          std::min(min.y + blockSize, grid.height())
+        };
+        if (detail::relaxBlock(grid, notPath, dist, min, max, first)) {
+          changed.store(true, std::memory_order_relaxed);
+        }
+      }, threads);
+    }
+    first = false;
+  } while (changed.load(std::memory_order_relaxed));
+
+  Utils::parallelFor(0, static_cast<size_t>(grid.height()), [&] (const size_t y) {
+    for (const Coord x : grid.hori()) {
+      Coord &tileDist = dist(x, static_cast<Coord>(y));
+      if (tileDist == detail::far_away) {
+        tileDist = unreachable;
+      }
+    }
+  }, threads);
+
+  return dist;
+}
+
+template <Grid::Coord Width, Grid::Coord Height, typename Layout>
+Grid::Grid<Grid::Dir, Width, Height, Layout> Grid::flowField(
+  const Grid<Coord, Width, Height, Layout> &dist
+) {
+  Grid<Dir, Width, Height, Layout> flow{dist.size(), Dir::none};
+  for (const Coord y : dist.vert()) {
+    for (const Coord x : dist.hori()) {
+      flow(x, y) = detail::flowDir(dist, {x, y});
+    }
+  }
+  return flow;
+}
+
+template <Grid::Coord Width, Grid::Coord Height, typename Layout>
+Grid::Grid<Grid::Dir, Width, Height, Layout> Grid::flowField(
+  Utils::parallel_t,
+  const Grid<Coord, Width, Height, Layout> &dist,
+  const unsigned threads
+) {
+  Grid<Dir, Width, Height, Layout> flow{dist.size(), Dir::none};
+  Utils::parallelFor(0, static_cast<size_t>(dist.height()), [&] (const size_t y) {
+    for (const Coord x : dist.hori()) {
+      flow(x, static_cast<Coord>(y)) = detail::flowDir(dist, {x, static_cast<Coord>(y)});
+    }
+  }, threads);
+  return flow;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Dir, Width, Height, Layout> Grid::flowField(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const std::vector<Pos> &goals
+) {
+  return flowField(distanceField(grid, notPath, goals));
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::Dir, Width, Height, Layout> Grid::flowField(
+  Utils::parallel_t,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const std::vector<Pos> &goals,
+  const unsigned threads
+) {
+  return flowField(
+    Utils::parallel,
+    distanceField(Utils::parallel, grid, notPath, goals, threads),
+    threads
+  );
+}
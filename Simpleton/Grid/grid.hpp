@@ -13,6 +13,8 @@
 #include <vector>
 #include "pos.hpp"
 #include <utility>
+#include <type_traits>
+#include "layout.hpp"
 #include "../Utils/numeric iterators.hpp"
 
 namespace Grid {
@@ -39,6 +41,8 @@ namespace Grid {
       }
       
     public:
+      // Iterators visit the tiles in storage order. Use toPos to get the
+      // position of a tile.
       auto begin() {
         return that().mTiles.begin();
       }
@@ -57,7 +61,14 @@ namespace Grid {
       auto cend() const {
         return that().mTiles.end();
       }
-      
+
+      Tile *data() {
+        return that().mTiles.data();
+      }
+      const Tile *data() const {
+        return that().mTiles.data();
+      }
+
       auto hori() const {
         return Utils::range(that().size().x);
       }
@@ -110,18 +121,38 @@ namespace Grid {
   
   constexpr Coord runtime = 0;
 
-  template <typename Tile_, Coord Width_ = runtime, Coord Height_ = runtime>
-  class Grid final : public detail::GridBase<Grid<Tile_, Width_, Height_>, Tile_> {
+  namespace detail {
+    // dynamic grids of bool are stored in a std::vector<bool> so their tiles
+    // are not contiguous and they don't have data()
+    template <typename Tile, Coord Width>
+    constexpr bool contiguous_tiles = !(std::is_same_v<Tile, bool> && Width == runtime);
+
+    // the tiles in each row are next to each other in memory
+    template <typename Tile, Coord Width, typename Layout>
+    constexpr bool row_major_tiles = contiguous_tiles<Tile, Width> && std::is_same_v<Layout, RowMajor>;
+  }
+
+  /// A 2D array of tiles. The layout (RowMajor, ZOrder or Tiled) determines
+  /// the order that tiles are stored in
+  template <
+    typename Tile_,
+    Coord Width_ = runtime,
+    Coord Height_ = runtime,
+    typename Layout_ = RowMajor
+  >
+  class Grid final : public detail::GridBase<Grid<Tile_, Width_, Height_, Layout_>, Tile_> {
   public:
     friend detail::GridBase<Grid, Tile_>;
   
     using Tile = Tile_;
+    using Layout = Layout_;
     static constexpr Coord Width = Width_;
     static constexpr Coord Height = Height_;
     using Tiles = std::array<Tile, Width * Height>;
     
     static_assert(Width > 0);
     static_assert(Height > 0);
+    static_assert(Layout::validSize(Width, Height), "Size is not valid for this layout");
     
     Grid() = default;
     // So that dynamic and static grids have compatible interfaces
@@ -165,33 +196,36 @@ namespace Grid {
 
     static size_t toIndex(const Pos pos) {
       assert(!outOfRange(pos));
-      return pos.y * Width + pos.x;
+      return Layout::toIndex(pos, size());
     }
     static Pos toPos(const size_t index) {
       assert(!outOfRange(index));
-      const Coord cindex = static_cast<Coord>(index);
-      return {cindex % Width, cindex / Width};
+      return Layout::toPos(index, size());
     }
   
   private:
     Tiles mTiles;
   };
 
-  template <typename Tile_>
-  class Grid<Tile_, runtime, runtime> final : public detail::GridBase<Grid<Tile_, runtime, runtime>, Tile_> {
+  template <typename Tile_, typename Layout_>
+  class Grid<Tile_, runtime, runtime, Layout_> final : public detail::GridBase<Grid<Tile_, runtime, runtime, Layout_>, Tile_> {
   public:
     friend detail::GridBase<Grid, Tile_>;
   
     using Tile = Tile_;
+    using Layout = Layout_;
+    static constexpr Coord Width = runtime;
+    static constexpr Coord Height = runtime;
     using Tiles = std::vector<Tile>;
   
     Grid()
       : mSize(0, 0) {}
     Grid(const Coord width, const Coord height, const Tile &tile = {})
-      : mTiles{static_cast<size_t>(width * height), tile},
+      : mTiles(static_cast<size_t>(width * height), tile),
         mSize{width, height} {
       assert(width > 0);
       assert(height > 0);
+      assert(Layout::validSize(width, height));
     }
     explicit Grid(const Pos size, const Tile &tile = {})
       : Grid{size.x, size.y, tile} {}
@@ -203,6 +237,7 @@ namespace Grid {
     void resize(const Pos size, const Tile &tile = {}) {
       assert(size.x > 0);
       assert(size.y > 0);
+      assert(Layout::validSize(size.x, size.y));
       mTiles.resize(static_cast<size_t>(size.x * size.y), tile);
       mSize = size;
     }
@@ -232,12 +267,11 @@ namespace Grid {
     
     size_t toIndex(const Pos pos) const {
       assert(!outOfRange(pos));
-      return pos.y * mSize.x + pos.x;
+      return Layout::toIndex(pos, mSize);
     }
     Pos toPos(const size_t index) const {
       assert(!outOfRange(index));
-      const Coord cindex = static_cast<Coord>(index);
-      return {cindex % mSize.x, cindex / mSize.x};
+      return Layout::toPos(index, mSize);
     }
   
   private:
@@ -0,0 +1,90 @@
+//
+//  hierarchical a star.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_hierarchical_a_star_hpp
+#define engine_grid_hierarchical_a_star_hpp
+
+#include "a star.hpp"
+
+namespace Grid {
+  /// Hierarchical path planner (HPA*). The grid is divided into square
+  /// clusters and the entrances between neighboring clusters are found ahead
+  /// of time. Queries search the graph of entrances and then fill in the tiles
+  /// within each cluster. Paths are near-optimal. The planner holds a
+  /// reference to the grid so update must be called when a tile changes.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  class HierarchicalAStar {
+  public:
+    using GridType = Grid<Tile, Width, Height, Layout>;
+
+    HierarchicalAStar(const GridType &, Function, Coord = 16);
+
+    /// Find all entrances and rebuild every cluster. Call this after the grid
+    /// is resized or after lots of tiles have changed
+    void rebuild();
+    /// Rebuild the cluster containing the tile (and the clusters next to it
+    /// if the tile is on a border). Call this after a tile changes
+    void update(Pos);
+
+    /// Find a path between two points. Returns an empty vector if there is no
+    /// path or if either point is not a path tile
+    std::vector<Pos> path(Pos, Pos);
+
+  private:
+    using Index = AStarWorkspace::Index;
+    static constexpr Coord unreachable = -1;
+
+    struct Edge {
+      Index to;
+      Coord cost;
+    };
+    struct Node {
+      Pos pos;
+      std::vector<Edge> edges;
+    };
+    struct Cluster {
+      std::vector<Node> nodes;
+    };
+
+    const GridType &grid;
+    Function notPath;
+    Coord clusterSize;
+    Pos numClusters;
+    Index maxNodes;
+    std::vector<Cluster> clusters;
+    // tiles on the low side of each entrance
+    std::vector<std::vector<Pos>> vertBorders;
+    std::vector<std::vector<Pos>> horiBorders;
+
+    AStarWorkspace workspace;
+    std::vector<Coord> startDist;
+    std::vector<Coord> endDist;
+    std::vector<Coord> localDist;
+    std::vector<Pos> queue;
+
+    bool blocked(Pos) const;
+    Pos clusterOf(Pos) const;
+    size_t clusterIndex(Pos) const;
+    Pos clusterMin(Pos) const;
+    Pos clusterMax(Pos) const;
+    Index findNode(size_t, Pos) const;
+
+    void findEntrances(std::vector<Pos> &, Pos, Pos);
+    void findVertEntrances(Pos);
+    void findHoriEntrances(Pos);
+    void buildCluster(Pos);
+
+    void distances(std::vector<Coord> &, Pos);
+    Coord distance(const std::vector<Coord> &, Pos, Pos) const;
+    void refine(std::vector<Pos> &, Pos, Pos);
+  };
+}
+
+#include "hierarchical a star.inl"
+
+#endif
@@ -0,0 +1,431 @@
+//
+//  hierarchical a star.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include "dir.hpp"
+#include "distance.hpp"
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::HierarchicalAStar(
+  const GridType &grid,
+  Function notPath,
+  const Coord clusterSize
+) : grid{grid},
+    notPath{std::move(notPath)},
+    clusterSize{clusterSize} {
+  assert(clusterSize > 1);
+  rebuild();
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::rebuild() {
+  numClusters = {
+    (grid.width() + clusterSize - 1) / clusterSize,
+    (grid.height() + clusterSize - 1) / clusterSize
+  };
+  // an entrance can only be on the edge of a cluster
+  maxNodes = static_cast<Index>(clusterSize * 4);
+
+  clusters.clear();
+  clusters.resize(static_cast<size_t>(numClusters.x * numClusters.y));
+  vertBorders.clear();
+  vertBorders.resize(static_cast<size_t>((numClusters.x - 1) * numClusters.y));
+  horiBorders.clear();
+  horiBorders.resize(static_cast<size_t>(numClusters.x * (numClusters.y - 1)));
+
+  for (Coord y = 0; y != numClusters.y; ++y) {
+    for (Coord x = 0; x != numClusters.x; ++x) {
+      if (x + 1 != numClusters.x) {
+        findVertEntrances({x, y});
+      }
+      if (y + 1 != numClusters.y) {
+        findHoriEntrances({x, y});
+      }
+    }
+  }
+  for (Coord y = 0; y != numClusters.y; ++y) {
+    for (Coord x = 0; x != numClusters.x; ++x) {
+      buildCluster({x, y});
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::update(const Pos pos) {
+  assert(!grid.outOfRange(pos));
+  const Pos cluster = clusterOf(pos);
+  const Pos min = clusterMin(cluster);
+  const Pos max = clusterMax(cluster);
+
+  // entrances only change if the tile is on a border so the clusters on the
+  // other side of the border only need to be rebuilt in that case
+  const bool left = pos.x == min.x && cluster.x != 0;
+  const bool right = pos.x == max.x - 1 && cluster.x + 1 != numClusters.x;
+  const bool down = pos.y == min.y && cluster.y != 0;
+  const bool up = pos.y == max.y - 1 && cluster.y + 1 != numClusters.y;
+
+  if (left) {
+    findVertEntrances({cluster.x - 1, cluster.y});
+  }
+  if (right) {
+    findVertEntrances(cluster);
+  }
+  if (down) {
+    findHoriEntrances({cluster.x, cluster.y - 1});
+  }
+  if (up) {
+    findHoriEntrances(cluster);
+  }
+
+  buildCluster(cluster);
+  if (left) {
+    buildCluster({cluster.x - 1, cluster.y});
+  }
+  if (right) {
+    buildCluster({cluster.x + 1, cluster.y});
+  }
+  if (down) {
+    buildCluster({cluster.x, cluster.y - 1});
+  }
+  if (up) {
+    buildCluster({cluster.x, cluster.y + 1});
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+std::vector<Grid::Pos> Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::path(
+  const Pos start,
+  const Pos end
+) {
+  if (
+    grid.outOfRange(start) || grid.outOfRange(end) ||
+    blocked(start) || blocked(end)
+  ) {
+    return {};
+  }
+  if (start == end) {
+    return {start};
+  }
+
+  // like astar, this searches from the end and finds the start
+  // start and end are inserted into the graph as temporary nodes
+
+  const size_t startCluster = clusterIndex(clusterOf(start));
+  const size_t endCluster = clusterIndex(clusterOf(end));
+  distances(startDist, start);
+  distances(endDist, end);
+
+  const Index startID = static_cast<Index>(clusters.size()) * maxNodes;
+  const Index endID = startID + 1;
+  workspace.reset(startID + 2);
+  workspace.relax(endID, AStarWorkspace::none, 0, sumAxis(start, end));
+
+  while (!workspace.empty()) {
+    const Index topID = workspace.pop();
+
+    if (topID == startID) {
+      std::vector<Pos> path;
+      path.reserve(static_cast<size_t>(workspace.cost(startID)) + 1);
+      path.push_back(start);
+      Pos prev = start;
+      for (Index id = workspace.parent(startID); id != AStarWorkspace::none; id = workspace.parent(id)) {
+        const Pos next = id == endID
+          ? end
+          : clusters[id / maxNodes].nodes[id % maxNodes].pos;
+        refine(path, prev, next);
+        prev = next;
+      }
+      return path;
+    }
+
+    const Coord topCost = workspace.cost(topID);
+    const auto visit = [&, topID] (const Index id, const Pos pos, const Coord cost) {
+      if (cost == unreachable || workspace.closed(id)) {
+        return;
+      }
+      const Coord pathCost = topCost + cost;
+      workspace.relax(id, topID, pathCost, pathCost + sumAxis(pos, start));
+    };
+
+    if (topID == endID) {
+      const std::vector<Node> &nodes = clusters[endCluster].nodes;
+      for (Index n = 0; n != nodes.size(); ++n) {
+        visit(
+          static_cast<Index>(endCluster) * maxNodes + n,
+          nodes[n].pos,
+          distance(endDist, end, nodes[n].pos)
+        );
+      }
+      if (endCluster == startCluster) {
+        visit(startID, start, distance(startDist, start, end));
+      }
+      continue;
+    }
+
+    const size_t clusterIdx = topID / maxNodes;
+    const Index clusterBase = static_cast<Index>(clusterIdx) * maxNodes;
+    const Cluster &cluster = clusters[clusterIdx];
+    const Node &node = cluster.nodes[topID % maxNodes];
+
+    for (const Edge &edge : node.edges) {
+      visit(clusterBase + edge.to, cluster.nodes[edge.to].pos, edge.cost);
+    }
+    for (const Dir dir : dir_range) {
+      const Pos neighPos = node.pos + toVec<Coord>(dir);
+      if (grid.outOfRange(neighPos)) {
+        continue;
+      }
+      const size_t neighCluster = clusterIndex(clusterOf(neighPos));
+      if (neighCluster == clusterIdx) {
+        continue;
+      }
+      const Index neighNode = findNode(neighCluster, neighPos);
+      if (neighNode != AStarWorkspace::none) {
+        visit(static_cast<Index>(neighCluster) * maxNodes + neighNode, neighPos, 1);
+      }
+    }
+    if (clusterIdx == startCluster) {
+      visit(startID, start, distance(startDist, start, node.pos));
+    }
+  }
+
+  // there is no path
+  return {};
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+bool Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::blocked(const Pos pos) const {
+  return notPath(grid[pos]);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Pos Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::clusterOf(const Pos pos) const {
+  return {pos.x / clusterSize, pos.y / clusterSize};
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+size_t Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::clusterIndex(const Pos cluster) const {
+  return static_cast<size_t>(cluster.y * numClusters.x + cluster.x);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Pos Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::clusterMin(const Pos cluster) const {
+  return {cluster.x * clusterSize, cluster.y * clusterSize};
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Pos Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::clusterMax(const Pos cluster) const {
+  const Pos min = clusterMin(cluster);
+  return {
+    std::min(min.x + clusterSize, grid.width()),
+    std::min(min.y + clusterSize, grid.height())
+  };
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+auto Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::findNode(
+  const size_t cluster,
+  const Pos pos
+) const -> Index {
+  const std::vector<Node> &nodes = clusters[cluster].nodes;
+  for (Index n = 0; n != nodes.size(); ++n) {
+    if (nodes[n].pos == pos) {
+      return n;
+    }
+  }
+  return AStarWorkspace::none;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::findEntrances(
+  std::vector<Pos> &entrances,
+  Pos pos,
+  const Pos step
+) {
+  // step runs along the border. The tiles on the other side of the border are
+  // one step across
+  const Pos across = {step.y, step.x};
+  entrances.clear();
+
+  // an entrance is a run of tiles that are open on both sides of the border.
+  // Short entrances get one transition in the middle and long entrances get
+  // one at each end
+  constexpr Coord long_entrance = 6;
+  const auto addEntrance = [&] (const Pos runStart, const Coord length) {
+    if (length < long_entrance) {
+      entrances.push_back(runStart + step * (length / 2));
+    } else {
+      entrances.push_back(runStart);
+      entrances.push_back(runStart + step * (length - 1));
+    }
+  };
+
+  Pos runStart = pos;
+  Coord length = 0;
+  for (Coord i = 0; i != clusterSize && !grid.outOfRange(pos); ++i) {
+    if (!blocked(pos) && !blocked(pos + across)) {
+      if (length == 0) {
+        runStart = pos;
+      }
+      ++length;
+    } else if (length != 0) {
+      addEntrance(runStart, length);
+      length = 0;
+    }
+    pos += step;
+  }
+  if (length != 0) {
+    addEntrance(runStart, length);
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::findVertEntrances(const Pos cluster) {
+  // the border between cluster and the cluster to its right
+  findEntrances(
+    vertBorders[static_cast<size_t>(cluster.y * (numClusters.x - 1) + cluster.x)],
+    {clusterMax(cluster).x - 1, clusterMin(cluster).y},
+    {0, 1}
+  );
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::findHoriEntrances(const Pos cluster) {
+  // the border between cluster and the cluster above it
+  findEntrances(
+    horiBorders[clusterIndex(cluster)],
+    {clusterMin(cluster).x, clusterMax(cluster).y - 1},
+    {1, 0}
+  );
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::buildCluster(const Pos cluster) {
+  const size_t index = clusterIndex(cluster);
+  std::vector<Node> &nodes = clusters[index].nodes;
+  nodes.clear();
+
+  const auto addNodes = [&] (const std::vector<Pos> &entrances, const Pos offset) {
+    for (const Pos entrance : entrances) {
+      const Pos pos = entrance + offset;
+      if (findNode(index, pos) == AStarWorkspace::none) {
+        nodes.push_back({pos, {}});
+      }
+    }
+  };
+
+  if (cluster.x != 0) {
+    addNodes(vertBorders[static_cast<size_t>(cluster.y * (numClusters.x - 1) + cluster.x - 1)], {1, 0});
+  }
+  if (cluster.x + 1 != numClusters.x) {
+    addNodes(vertBorders[static_cast<size_t>(cluster.y * (numClusters.x - 1) + cluster.x)], {0, 0});
+  }
+  if (cluster.y != 0) {
+    addNodes(horiBorders[clusterIndex({cluster.x, cluster.y - 1})], {0, 1});
+  }
+  if (cluster.y + 1 != numClusters.y) {
+    addNodes(horiBorders[index], {0, 0});
+  }
+  assert(nodes.size() <= maxNodes);
+
+  for (Node &node : nodes) {
+    distances(localDist, node.pos);
+    for (Index n = 0; n != nodes.size(); ++n) {
+      const Coord cost = distance(localDist, node.pos, nodes[n].pos);
+      if (cost > 0) {
+        node.edges.push_back({n, cost});
+      }
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::distances(
+  std::vector<Coord> &dist,
+  const Pos origin
+) {
+  // breadth-first search that doesn't leave the cluster
+  const Pos cluster = clusterOf(origin);
+  const Pos min = clusterMin(cluster);
+  const Pos max = clusterMax(cluster);
+  const auto local = [min, this] (const Pos pos) {
+    return static_cast<size_t>((pos.y - min.y) * clusterSize + (pos.x - min.x));
+  };
+
+  dist.assign(static_cast<size_t>(clusterSize * clusterSize), unreachable);
+  queue.clear();
+  queue.push_back(origin);
+  dist[local(origin)] = 0;
+
+  for (size_t q = 0; q != queue.size(); ++q) {
+    const Pos pos = queue[q];
+    const Coord neighDist = dist[local(pos)] + 1;
+    for (const Dir dir : dir_range) {
+      const Pos neighPos = pos + toVec<Coord>(dir);
+      if (
+        neighPos.x < min.x || neighPos.y < min.y ||
+        neighPos.x >= max.x || neighPos.y >= max.y
+      ) {
+        continue;
+      }
+      Coord &neighDistRef = dist[local(neighPos)];
+      if (neighDistRef != unreachable || blocked(neighPos)) {
+        continue;
+      }
+      neighDistRef = neighDist;
+      queue.push_back(neighPos);
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Coord Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::distance(
+  const std::vector<Coord> &dist,
+  const Pos origin,
+  const Pos pos
+) const {
+  const Pos min = clusterMin(clusterOf(origin));
+  assert(clusterOf(origin) == clusterOf(pos));
+  return dist[static_cast<size_t>((pos.y - min.y) * clusterSize + (pos.x - min.x))];
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::HierarchicalAStar<Tile, Width, Height, Layout, Function>::refine(
+  std::vector<Pos> &path,
+  Pos pos,
+  const Pos next
+) {
+  if (sumAxis(pos, next) == 1) {
+    // stepping between clusters
+    path.push_back(next);
+    return;
+  }
+
+  // walk down the distance field of the destination
+  distances(localDist, next);
+  Coord dist = distance(localDist, next, pos);
+  assert(dist != unreachable);
+  const Pos min = clusterMin(clusterOf(next));
+  const Pos max = clusterMax(clusterOf(next));
+  while (dist != 0) {
+    for (const Dir dir : dir_range) {
+      const Pos neighPos = pos + toVec<Coord>(dir);
+      if (
+        neighPos.x < min.x || neighPos.y < min.y ||
+        neighPos.x >= max.x || neighPos.y >= max.y
+      ) {
+        continue;
+      }
+      if (distance(localDist, next, neighPos) == dist - 1) {
+        pos = neighPos;
+        --dist;
+        path.push_back(pos);
+        break;
+      }
+    }
+  }
+}
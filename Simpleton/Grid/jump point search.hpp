@@ -0,0 +1,39 @@
+//
+//  jump point search.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_jump_point_search_hpp
+#define engine_grid_jump_point_search_hpp
+
+#include "a star.hpp"
+
+namespace Grid {
+  /// Jump Point Search for grids where every path tile has the same cost. The
+  /// movement policy is EightWay or EightWayNoCorners. Finds paths with the
+  /// same cost as astar with the same movement policy but only expands jump
+  /// points (the tiles where a shortest path may have to turn because of a
+  /// wall). Runs of open tiles between jump points are scanned without going
+  /// through the queue so on open maps this expands far fewer tiles than
+  /// astar. Returns the full path (every tile) or an empty vector if there is
+  /// no path.
+  template <
+    typename Movement = EightWayNoCorners,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function
+  >
+  std::vector<Pos> jps(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Pos);
+
+  /// Jump Point Search. The workspace should be reused for repeated queries.
+  template <
+    typename Movement = EightWayNoCorners,
+    typename Tile, Coord Width, Coord Height, typename Layout, typename Function
+  >
+  std::vector<Pos> jps(AStarWorkspace &, const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Pos);
+}
+
+#include "jump point search.inl"
+
+#endif
@@ -0,0 +1,268 @@
+//
+//  jump point search.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include "dir.hpp"
+
+// A jump moves in a straight line or diagonally until it reaches the goal or
+// a tile with a forced neighbor. A forced neighbor is a tile beside the jump
+// that can't be reached optimally without turning at the current tile.
+// Straight jumps can have forced neighbors. Diagonal jumps also stop when a
+// straight jump from the current tile along either axis would stop. When
+// corners can be cut, a diagonal jump can also have forced neighbors.
+
+namespace Grid::detail {
+  constexpr Pos no_jump_point = {-1, -1};
+
+  template <typename Grid, typename Function>
+  bool jpsWalk(const Grid &grid, Function &notPath, const Pos pos) {
+    return !grid.outOfRange(pos) && !notPath(grid[pos]);
+  }
+
+  // Is there a forced neighbor on this side of a jump that has reached pos?
+  template <typename Movement, typename Grid, typename Function>
+  bool jpsForced(
+    const Grid &grid,
+    Function &notPath,
+    const Pos pos,
+    const Pos step,
+    const Pos side
+  ) {
+    if constexpr (Movement::cut_corners) {
+      // the tile diagonally ahead can only be reached by turning here
+      return !jpsWalk(grid, notPath, pos + side) &&
+              jpsWalk(grid, notPath, pos + step + side);
+    } else {
+      // the tile beside can't be reached diagonally from behind
+      return !jpsWalk(grid, notPath, pos - step + side) &&
+              jpsWalk(grid, notPath, pos + side);
+    }
+  }
+
+  // The tiles beside the jump are read once each. A tile beside the previous
+  // step is behind the tile beside the current step
+  template <typename Movement, typename Grid, typename Function>
+  Pos jpsJumpStraight(
+    const Grid &grid,
+    Function &notPath,
+    Pos pos,
+    const Pos step,
+    const Pos goal
+  ) {
+    const Pos side = {step.y, step.x};
+    if constexpr (Movement::cut_corners) {
+      // the tiles beside the current step
+      bool left = jpsWalk(grid, notPath, pos + step + side);
+      bool right = jpsWalk(grid, notPath, pos + step - side);
+      while (true) {
+        pos += step;
+        if (!jpsWalk(grid, notPath, pos)) {
+          return no_jump_point;
+        }
+        const bool aheadLeft = jpsWalk(grid, notPath, pos + step + side);
+        const bool aheadRight = jpsWalk(grid, notPath, pos + step - side);
+        if (pos == goal || (!left && aheadLeft) || (!right && aheadRight)) {
+          return pos;
+        }
+        left = aheadLeft;
+        right = aheadRight;
+      }
+    } else {
+      // the tiles beside the previous step
+      bool left = jpsWalk(grid, notPath, pos + side);
+      bool right = jpsWalk(grid, notPath, pos - side);
+      while (true) {
+        pos += step;
+        if (!jpsWalk(grid, notPath, pos)) {
+          return no_jump_point;
+        }
+        const bool nextLeft = jpsWalk(grid, notPath, pos + side);
+        const bool nextRight = jpsWalk(grid, notPath, pos - side);
+        if (pos == goal || (!left && nextLeft) || (!right && nextRight)) {
+          return pos;
+        }
+        left = nextLeft;
+        right = nextRight;
+      }
+    }
+  }
+
+  template <typename Movement, typename Grid, typename Function>
+  Pos jpsJumpDiag(
+    const Grid &grid,
+    Function &notPath,
+    Pos pos,
+    const Pos step,
+    const Pos goal
+  ) {
+    const Pos hori = {step.x, 0};
+    const Pos vert = {0, step.y};
+    while (true) {
+      if constexpr (!Movement::cut_corners) {
+        if (!jpsWalk(grid, notPath, pos + hori) || !jpsWalk(grid, notPath, pos + vert)) {
+          return no_jump_point;
+        }
+      }
+      pos += step;
+      if (!jpsWalk(grid, notPath, pos)) {
+        return no_jump_point;
+      }
+      if (pos == goal) {
+        return pos;
+      }
+      if constexpr (Movement::cut_corners) {
+        if (
+          jpsForced<Movement>(grid, notPath, pos, vert, -hori) ||
+          jpsForced<Movement>(grid, notPath, pos, hori, -vert)
+        ) {
+          return pos;
+        }
+      }
+      if (
+        jpsJumpStraight<Movement>(grid, notPath, pos, hori, goal) != no_jump_point ||
+        jpsJumpStraight<Movement>(grid, notPath, pos, vert, goal) != no_jump_point
+      ) {
+        return pos;
+      }
+    }
+  }
+
+  inline Pos jpsStep(const Pos from, const Pos to) {
+    return {
+      (to.x > from.x) - (to.x < from.x),
+      (to.y > from.y) - (to.y < from.y)
+    };
+  }
+}
+
+template <
+  typename Movement,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function
+>
+std::vector<Grid::Pos> Grid::jps(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const Pos start,
+  const Pos end
+) {
+  AStarWorkspace workspace;
+  return jps<Movement>(workspace, grid, notPath, start, end);
+}
+
+template <
+  typename Movement,
+  typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function
+>
+std::vector<Grid::Pos> Grid::jps(
+  AStarWorkspace &workspace,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const Pos start,
+  const Pos end
+) {
+  static_assert(Movement::diagonals, "jps needs EightWay or EightWayNoCorners");
+
+  if (grid.outOfRange(start) || grid.outOfRange(end)) {
+    return {};
+  }
+
+  // like astar, this searches from the end and finds the start
+
+  using Index = AStarWorkspace::Index;
+  const Index startIndex = static_cast<Index>(grid.toIndex(start));
+  const Index endIndex = static_cast<Index>(grid.toIndex(end));
+
+  workspace.reset(grid.area());
+  workspace.relax(endIndex, AStarWorkspace::none, 0, Octile::dist<Movement>(start, end));
+
+  while (!workspace.empty()) {
+    const Index topIndex = workspace.pop();
+
+    if (topIndex == startIndex) {
+      // fill in the tiles between the jump points
+      std::vector<Pos> path;
+      Pos pos = start;
+      path.push_back(pos);
+      for (Index i = workspace.parent(startIndex); i != AStarWorkspace::none; i = workspace.parent(i)) {
+        const Pos jumpPoint = grid.toPos(i);
+        const Pos step = detail::jpsStep(pos, jumpPoint);
+        while (pos != jumpPoint) {
+          pos += step;
+          path.push_back(pos);
+        }
+      }
+      return path;
+    }
+
+    const Pos topPos = grid.toPos(topIndex);
+    const Coord topCost = workspace.cost(topIndex);
+    const Index parentIndex = workspace.parent(topIndex);
+
+    const auto jump = [&] (const Pos step) {
+      const Pos jumpPoint = step.x != 0 && step.y != 0
+        ? detail::jpsJumpDiag<Movement>(grid, notPath, topPos, step, start)
+        : detail::jpsJumpStraight<Movement>(grid, notPath, topPos, step, start);
+      if (jumpPoint == detail::no_jump_point) {
+        return;
+      }
+      const Index jumpIndex = static_cast<Index>(grid.toIndex(jumpPoint));
+      if (workspace.closed(jumpIndex)) {
+        return;
+      }
+      // jump points are always in a straight line or on a diagonal
+      const Coord cost = topCost + Octile::dist<Movement>(topPos, jumpPoint);
+      workspace.relax(
+        jumpIndex,
+        topIndex,
+        cost,
+        cost + Octile::dist<Movement>(jumpPoint, start)
+      );
+    };
+
+    if (parentIndex == AStarWorkspace::none) {
+      // the first tile has no direction so all neighbors are natural
+      for (const Dir dir : dir_range) {
+        const Pos straight = toVec<Coord>(dir);
+        jump(straight);
+        jump(straight + toVec<Coord>(rotateCW(dir)));
+      }
+      continue;
+    }
+
+    const Pos step = detail::jpsStep(grid.toPos(parentIndex), topPos);
+    if (step.x != 0 && step.y != 0) {
+      const Pos hori = {step.x, 0};
+      const Pos vert = {0, step.y};
+      jump(hori);
+      jump(vert);
+      jump(step);
+      if constexpr (Movement::cut_corners) {
+        if (!detail::jpsWalk(grid, notPath, topPos - hori)) {
+          jump(vert - hori);
+        }
+        if (!detail::jpsWalk(grid, notPath, topPos - vert)) {
+          jump(hori - vert);
+        }
+      }
+    } else {
+      jump(step);
+      const Dir dir = fromVec(step);
+      for (const Dir sideDir : {rotateCW(dir), rotateCCW(dir)}) {
+        const Pos side = toVec<Coord>(sideDir);
+        if (detail::jpsForced<Movement>(grid, notPath, topPos, step, side)) {
+          if constexpr (!Movement::cut_corners) {
+            jump(side);
+          }
+          jump(step + side);
+        }
+      }
+    }
+  }
+
+  // there is no path
+  return {};
+}
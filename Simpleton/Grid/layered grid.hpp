@@ -0,0 +1,126 @@
+//
+//  layered grid.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_layered_grid_hpp
+#define engine_grid_layered_grid_hpp
+
+#include <tuple>
+#include "grid.hpp"
+#include "../Utils/tuple.hpp"
+
+namespace Grid {
+  /// A grid where each field of a tile is stored in its own layer. Each layer
+  /// is a Grid of one field so a pass that only reads one field only touches
+  /// the memory of that field. The layers can be passed to astar, blit, the
+  /// transforms and everything else that takes a Grid. All layers are always
+  /// the same size.
+  template <typename... Fields>
+  class LayeredGrid {
+  public:
+    static_assert(sizeof...(Fields) > 0, "LayeredGrid needs at least one field");
+
+    static constexpr size_t num_layers = sizeof...(Fields);
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+    template <size_t I>
+    using Layer = Grid<Field<I>>;
+
+    LayeredGrid() = default;
+    LayeredGrid(Coord, Coord);
+    explicit LayeredGrid(Pos);
+    /// Fill each layer with a tile
+    LayeredGrid(Pos, const Fields &...);
+
+    void clear();
+    void resize(Pos, const Fields &...);
+    void fill(const Fields &...);
+
+    Pos size() const {
+      return std::get<0>(layers).size();
+    }
+    Coord width() const {
+      return std::get<0>(layers).width();
+    }
+    Coord height() const {
+      return std::get<0>(layers).height();
+    }
+    size_t area() const {
+      return std::get<0>(layers).area();
+    }
+    auto hori() const {
+      return std::get<0>(layers).hori();
+    }
+    auto vert() const {
+      return std::get<0>(layers).vert();
+    }
+    bool outOfRange(const Pos pos) const {
+      return std::get<0>(layers).outOfRange(pos);
+    }
+    bool outOfRange(const size_t index) const {
+      return std::get<0>(layers).outOfRange(index);
+    }
+    size_t toIndex(const Pos pos) const {
+      return std::get<0>(layers).toIndex(pos);
+    }
+    Pos toPos(const size_t index) const {
+      return std::get<0>(layers).toPos(index);
+    }
+
+    /// Get the layer of a field by index. Don't resize the layer
+    template <size_t I>
+    Layer<I> &layer() {
+      return std::get<I>(layers);
+    }
+    template <size_t I>
+    const Layer<I> &layer() const {
+      return std::get<I>(layers);
+    }
+    /// Get the layer of a field by type. The type must be unique
+    template <typename Type>
+    Grid<Type> &layer() {
+      return std::get<Grid<Type>>(layers);
+    }
+    template <typename Type>
+    const Grid<Type> &layer() const {
+      return std::get<Grid<Type>>(layers);
+    }
+
+    /// Get one field of a tile
+    template <size_t I>
+    decltype(auto) get(const Pos pos) {
+      return std::get<I>(layers)[pos];
+    }
+    template <size_t I>
+    decltype(auto) get(const Pos pos) const {
+      return std::get<I>(layers)[pos];
+    }
+
+    /// Get a tuple of references to every field of a tile
+    auto tile(Pos);
+    auto tile(Pos) const;
+    /// Set every field of a tile
+    void set(Pos, const Fields &...);
+
+  private:
+    std::tuple<Grid<Fields>...> layers;
+
+    template <size_t... Is>
+    auto tileImpl(size_t, std::index_sequence<Is...>);
+    template <size_t... Is>
+    auto tileImpl(size_t, std::index_sequence<Is...>) const;
+  };
+
+  /// Split a grid of structs into a layered grid with a layer for each of the
+  /// given members
+  template <typename Tile, typename... Fields>
+  LayeredGrid<Fields...> makeLayeredGrid(const Grid<Tile> &, Fields Tile::*...);
+}
+
+#include "layered grid.inl"
+
+#endif
@@ -0,0 +1,88 @@
+//
+//  layered grid.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+template <typename... Fields>
+Grid::LayeredGrid<Fields...>::LayeredGrid(const Coord width, const Coord height)
+  : layers{Grid<Fields>{width, height}...} {}
+
+template <typename... Fields>
+Grid::LayeredGrid<Fields...>::LayeredGrid(const Pos size)
+  : layers{Grid<Fields>{size}...} {}
+
+template <typename... Fields>
+Grid::LayeredGrid<Fields...>::LayeredGrid(const Pos size, const Fields &... tiles)
+  : layers{Grid<Fields>{size, tiles}...} {}
+
+template <typename... Fields>
+void Grid::LayeredGrid<Fields...>::clear() {
+  std::apply([] (Grid<Fields> &... layer) {
+    (layer.clear(), ...);
+  }, layers);
+}
+
+template <typename... Fields>
+void Grid::LayeredGrid<Fields...>::resize(const Pos size, const Fields &... tiles) {
+  std::apply([&] (Grid<Fields> &... layer) {
+    (layer.resize(size, tiles), ...);
+  }, layers);
+}
+
+template <typename... Fields>
+void Grid::LayeredGrid<Fields...>::fill(const Fields &... tiles) {
+  std::apply([&] (Grid<Fields> &... layer) {
+    (layer.fill(tiles), ...);
+  }, layers);
+}
+
+template <typename... Fields>
+auto Grid::LayeredGrid<Fields...>::tile(const Pos pos) {
+  return tileImpl(toIndex(pos), std::index_sequence_for<Fields...>{});
+}
+
+template <typename... Fields>
+auto Grid::LayeredGrid<Fields...>::tile(const Pos pos) const {
+  return tileImpl(toIndex(pos), std::index_sequence_for<Fields...>{});
+}
+
+template <typename... Fields>
+void Grid::LayeredGrid<Fields...>::set(const Pos pos, const Fields &... tiles) {
+  const size_t index = toIndex(pos);
+  std::apply([&] (Grid<Fields> &... layer) {
+    ((layer[index] = tiles), ...);
+  }, layers);
+}
+
+template <typename... Fields>
+template <size_t... Is>
+auto Grid::LayeredGrid<Fields...>::tileImpl(const size_t index, std::index_sequence<Is...>) {
+  return std::tuple<decltype(std::get<Is>(layers)[index])...>{std::get<Is>(layers)[index]...};
+}
+
+template <typename... Fields>
+template <size_t... Is>
+auto Grid::LayeredGrid<Fields...>::tileImpl(const size_t index, std::index_sequence<Is...>) const {
+  return std::tuple<decltype(std::get<Is>(layers)[index])...>{std::get<Is>(layers)[index]...};
+}
+
+template <typename Tile, typename... Fields>
+Grid::LayeredGrid<Fields...> Grid::makeLayeredGrid(
+  const Grid<Tile> &grid,
+  Fields Tile::*... members
+) {
+  LayeredGrid<Fields...> layered{grid.size()};
+  // one pass per layer so that each layer is written in order
+  Utils::forEachIndex<sizeof...(Fields)>([&] (const auto i) {
+    constexpr size_t I = UTILS_VALUE(i);
+    const auto member = std::get<I>(std::make_tuple(members...));
+    auto &layer = layered.template layer<I>();
+    for (size_t t = 0; t != grid.area(); ++t) {
+      layer[t] = grid[t].*member;
+    }
+  });
+  return layered;
+}
@@ -0,0 +1,111 @@
+//
+//  layout.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_layout_hpp
+#define engine_grid_layout_hpp
+
+#include <cstddef>
+#include <algorithm>
+#include "morton.hpp"
+
+namespace Grid {
+  // A layout maps between positions and indicies into the storage of a grid.
+  // Layouts never pad the storage so a grid always has width * height tiles.
+
+  /// Tiles are stored one row after another. This is the default
+  struct RowMajor {
+    static constexpr bool validSize(Coord, Coord) {
+      return true;
+    }
+    static size_t toIndex(const Pos pos, const Pos size) {
+      return static_cast<size_t>(pos.y) * static_cast<size_t>(size.x) + static_cast<size_t>(pos.x);
+    }
+    static Pos toPos(const size_t index, const Pos size) {
+      const Coord cindex = static_cast<Coord>(index);
+      return {cindex % size.x, cindex / size.x};
+    }
+  };
+
+  /// Tiles are stored along a Z-order curve (Morton order) so that tiles that
+  /// are close together in 2D are usually close together in memory. The width
+  /// and height must be powers of 2. If the grid is not square, the Z-order
+  /// curve covers squares that are stored one after another. Every access
+  /// computes a Morton code so this layout is only worth using when BMI2 is
+  /// enabled (-mbmi2). Square grids are indexed with a single Morton code
+  struct ZOrder {
+    static constexpr bool validSize(const Coord width, const Coord height) {
+      return width > 0 && height > 0 &&
+             (width & (width - 1)) == 0 &&
+             (height & (height - 1)) == 0;
+    }
+    static size_t toIndex(const Pos pos, const Pos size) {
+      if (size.x == size.y) {
+        // the whole grid is one square
+        return static_cast<size_t>(toMorton(pos));
+      }
+      const unsigned bits = squareBits(size);
+      const Coord mask = (Coord{1} << bits) - 1;
+      const Morton low = toMorton({pos.x & mask, pos.y & mask});
+      // only one of these is non-zero
+      const Morton high = static_cast<Morton>((pos.x | pos.y) >> bits);
+      return static_cast<size_t>(low | (high << (bits * 2)));
+    }
+    static Pos toPos(const size_t index, const Pos size) {
+      if (size.x == size.y) {
+        return fromMorton(static_cast<Morton>(index));
+      }
+      const unsigned bits = squareBits(size);
+      const Morton morton = static_cast<Morton>(index);
+      Pos pos = fromMorton(morton & ((Morton{1} << (bits * 2)) - 1));
+      const Coord high = static_cast<Coord>(morton >> (bits * 2)) << bits;
+      if (size.x > size.y) {
+        pos.x |= high;
+      } else {
+        pos.y |= high;
+      }
+      return pos;
+    }
+
+  private:
+    // log2 of the side length of the squares
+    static unsigned squareBits(const Pos size) {
+      return static_cast<unsigned>(__builtin_ctz(static_cast<unsigned>(std::min(size.x, size.y))));
+    }
+  };
+
+  /// Tiles are stored in square blocks. The blocks are stored one row after
+  /// another and the tiles within a block are stored one row after another.
+  /// The width and height must be multiples of the block size
+  template <Coord BlockSize = 8>
+  struct Tiled {
+    static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "Block size must be a power of 2");
+    static constexpr Coord block_size = BlockSize;
+    static constexpr Coord block_area = BlockSize * BlockSize;
+
+    static constexpr bool validSize(const Coord width, const Coord height) {
+      return width % BlockSize == 0 && height % BlockSize == 0;
+    }
+    static size_t toIndex(const Pos pos, const Pos size) {
+      const Coord blocksPerRow = size.x / BlockSize;
+      const Coord block = (pos.y / BlockSize) * blocksPerRow + pos.x / BlockSize;
+      const Coord inner = (pos.y % BlockSize) * BlockSize + pos.x % BlockSize;
+      return static_cast<size_t>(block) * block_area + static_cast<size_t>(inner);
+    }
+    static Pos toPos(const size_t index, const Pos size) {
+      const Coord blocksPerRow = size.x / BlockSize;
+      const Coord block = static_cast<Coord>(index / block_area);
+      const Coord inner = static_cast<Coord>(index % block_area);
+      return {
+        (block % blocksPerRow) * BlockSize + inner % BlockSize,
+        (block / blocksPerRow) * BlockSize + inner / BlockSize
+      };
+    }
+  };
+}
+
+#endif
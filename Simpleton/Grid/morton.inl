@@ -8,6 +8,10 @@
 
 #include <type_traits>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 //https://github.com/Forceflow/libmorton
 
 namespace Grid::detail {
@@ -36,14 +40,26 @@ namespace Grid::detail {
 inline Grid::Morton Grid::toMorton(const Pos pos) {
   static_assert(std::is_same_v<Morton, uint64_t>);
   static_assert(std::is_same_v<Coord, int32_t>);
+  #ifdef __BMI2__
+  return _pdep_u64(static_cast<uint32_t>(pos.x), 0x5555555555555555)
+       | _pdep_u64(static_cast<uint32_t>(pos.y), 0xAAAAAAAAAAAAAAAA);
+  #else
   return detail::splitBits(pos.x) | (detail::splitBits(pos.y) << 1);
+  #endif
 }
 
 inline Grid::Pos Grid::fromMorton(const Morton morton) {
   static_assert(std::is_same_v<Morton, uint64_t>);
   static_assert(std::is_same_v<Coord, int32_t>);
+  #ifdef __BMI2__
+  return {
+    static_cast<Coord>(_pext_u64(morton, 0x5555555555555555)),
+    static_cast<Coord>(_pext_u64(morton, 0xAAAAAAAAAAAAAAAA))
+  };
+  #else
   return {
-    detail::getSecondBits(morton),
-    detail::getSecondBits(morton >> 1)
+    static_cast<Coord>(detail::getSecondBits(morton)),
+    static_cast<Coord>(detail::getSecondBits(morton >> 1))
   };
+  #endif
 }
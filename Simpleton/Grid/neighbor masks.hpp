@@ -0,0 +1,70 @@
+//
+//  neighbor masks.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_neighbor_masks_hpp
+#define engine_grid_neighbor_masks_hpp
+
+#include "grid.hpp"
+#include "dir bits.hpp"
+
+namespace Grid {
+  /// A bitset of the eight tiles around a tile. The low four bits are the
+  /// same as DirBits. The high four bits are the corners going clockwise from
+  /// up-right
+  using CornerBits = uint8_t;
+
+  /// Get the bit of the corner that is clockwise from a direction. The corner
+  /// clockwise from Dir::up is the up-right corner
+  constexpr CornerBits cornerBit(const Dir dir) {
+    return static_cast<CornerBits>(CornerBits{16} << static_cast<DirType>(dir));
+  }
+
+  /// Find which of the four tiles around each tile match the predicate. This
+  /// is used for choosing autotile sprites. The edge is whether tiles outside
+  /// of the grid match. Whole rows are done at a time with no branches.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<DirBits, Width, Height, Layout> neighborMasks(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    bool = false
+  );
+
+  /// Find which of the eight tiles around each tile match the predicate
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<CornerBits, Width, Height, Layout> cornerMasks(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    bool = false
+  );
+
+  /// Update the masks around a tile that has changed. Only the masks of the
+  /// tiles next to the changed tile are recomputed
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  void updateNeighborMasks(
+    Grid<DirBits, Width, Height, Layout> &,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    Pos,
+    bool = false
+  );
+
+  /// Update the masks around a tile that has changed. Only the masks of the
+  /// 3x3 tiles around the changed tile are recomputed
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  void updateCornerMasks(
+    Grid<CornerBits, Width, Height, Layout> &,
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&,
+    Pos,
+    bool = false
+  );
+}
+
+#include "neighbor masks.inl"
+
+#endif
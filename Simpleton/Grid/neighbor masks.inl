@@ -0,0 +1,174 @@
+//
+//  neighbor masks.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+namespace Grid::detail {
+  // The predicate for every tile with a tile of padding around the edge. Row
+  // y of the grid is row y + 1 of the padded rows
+  class PaddedMatches {
+  public:
+    template <typename GridType, typename Function>
+    PaddedMatches(const GridType &grid, Function &pred, const bool edge)
+      : stride{static_cast<size_t>(grid.width()) + 2},
+        matches(stride * (static_cast<size_t>(grid.height()) + 2), edge) {
+      for (const Coord y : grid.vert()) {
+        uint8_t *const row = this->row(y);
+        for (const Coord x : grid.hori()) {
+          row[x] = static_cast<bool>(pred(grid(x, y)));
+        }
+      }
+    }
+
+    // pointer to the first tile in a row. The tile before it is padding
+    uint8_t *row(const Coord y) {
+      return matches.data() + static_cast<size_t>(y + 1) * stride + 1;
+    }
+
+  private:
+    size_t stride;
+    std::vector<uint8_t> matches;
+  };
+
+  // tiles don't always have contiguous rows so the masks are written to a
+  // row buffer first
+  template <typename Mask, Coord Width, Coord Height, typename Layout>
+  void storeMaskRow(
+    Grid<Mask, Width, Height, Layout> &masks,
+    const Coord y,
+    const uint8_t *row
+  ) {
+    if constexpr (std::is_same_v<Layout, RowMajor>) {
+      Mask *const out = masks.data() + static_cast<size_t>(y) * static_cast<size_t>(masks.width());
+      for (const Coord x : masks.hori()) {
+        out[x] = static_cast<Mask>(row[x]);
+      }
+    } else {
+      for (const Coord x : masks.hori()) {
+        masks(x, y) = static_cast<Mask>(row[x]);
+      }
+    }
+  }
+
+  template <typename Mask, typename GridType, typename Function>
+  Mask maskAt(const GridType &grid, Function &pred, const Pos pos, const bool edge) {
+    constexpr Pos offsets[8] = {
+      {0, 1}, {1, 0}, {0, -1}, {-1, 0},
+      {1, 1}, {1, -1}, {-1, -1}, {-1, 1}
+    };
+    constexpr size_t numOffsets = std::is_same_v<Mask, DirBits> ? 4 : 8;
+    unsigned mask = 0;
+    for (size_t o = 0; o != numOffsets; ++o) {
+      const Pos neigh = pos + offsets[o];
+      const bool match = grid.outOfRange(neigh) ? edge : static_cast<bool>(pred(grid[neigh]));
+      mask |= unsigned{match} << o;
+    }
+    return static_cast<Mask>(mask);
+  }
+
+  template <typename Mask, Coord Width, Coord Height, typename Layout, typename GridType, typename Function>
+  void updateMasks(
+    Grid<Mask, Width, Height, Layout> &masks,
+    const GridType &grid,
+    Function &pred,
+    const Pos pos,
+    const bool edge
+  ) {
+    assert(masks.size() == grid.size());
+    for (Coord y = pos.y - 1; y <= pos.y + 1; ++y) {
+      for (Coord x = pos.x - 1; x <= pos.x + 1; ++x) {
+        if (!masks.outOfRange({x, y})) {
+          masks(x, y) = maskAt<Mask>(grid, pred, {x, y}, edge);
+        }
+      }
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::DirBits, Width, Height, Layout> Grid::neighborMasks(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&pred,
+  const bool edge
+) {
+  detail::PaddedMatches matches{grid, pred, edge};
+  Grid<DirBits, Width, Height, Layout> masks{grid.size()};
+  std::vector<uint8_t> maskRow(static_cast<size_t>(grid.width()));
+  const size_t width = maskRow.size();
+
+  for (const Coord y : grid.vert()) {
+    const uint8_t *const above = matches.row(y + 1);
+    const uint8_t *const row = matches.row(y);
+    const uint8_t *const below = matches.row(y - 1);
+    uint8_t *const out = maskRow.data();
+    // the padding means that there are no branches so this is vectorized
+    for (size_t x = 0; x != width; ++x) {
+      out[x] = static_cast<uint8_t>(
+        above[x] |
+        (row[x + 1] << 1) |
+        (below[x] << 2) |
+        (row[x - 1] << 3)
+      );
+    }
+    detail::storeMaskRow(masks, y, out);
+  }
+  return masks;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::CornerBits, Width, Height, Layout> Grid::cornerMasks(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&pred,
+  const bool edge
+) {
+  detail::PaddedMatches matches{grid, pred, edge};
+  Grid<CornerBits, Width, Height, Layout> masks{grid.size()};
+  std::vector<uint8_t> maskRow(static_cast<size_t>(grid.width()));
+  const size_t width = maskRow.size();
+
+  for (const Coord y : grid.vert()) {
+    const uint8_t *const above = matches.row(y + 1);
+    const uint8_t *const row = matches.row(y);
+    const uint8_t *const below = matches.row(y - 1);
+    uint8_t *const out = maskRow.data();
+    for (size_t x = 0; x != width; ++x) {
+      out[x] = static_cast<uint8_t>(
+        above[x] |
+        (row[x + 1] << 1) |
+        (below[x] << 2) |
+        (row[x - 1] << 3) |
+        (above[x + 1] << 4) |
+        (below[x + 1] << 5) |
+        (below[x - 1] << 6) |
+        (above[x - 1] << 7)
+      );
+    }
+    detail::storeMaskRow(masks, y, out);
+  }
+  return masks;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::updateNeighborMasks(
+  Grid<DirBits, Width, Height, Layout> &masks,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&pred,
+  const Pos pos,
+  const bool edge
+) {
+  detail::updateMasks(masks, grid, pred, pos, edge);
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::updateCornerMasks(
+  Grid<CornerBits, Width, Height, Layout> &masks,
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&pred,
+  const Pos pos,
+  const bool edge
+) {
+  detail::updateMasks(masks, grid, pred, pos, edge);
+}
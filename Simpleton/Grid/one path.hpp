@@ -10,13 +10,20 @@
 #define engine_grid_one_path_hpp
 
 #include "grid.hpp"
+#include "bit grid.hpp"
 
 namespace Grid {
   /// Finds the path between two points but assumes that there is only one path.
   /// Hangs on loops and returns {} on dead ends. This is much faster than A* if
   /// there is only one path.
-  template <typename Tile, Coord Width, Coord Height, typename Function>
-  std::vector<Pos> onePath(const Grid<Tile, Width, Height> &, Function &&, Pos, Pos);
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  std::vector<Pos> onePath(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos, Pos);
+  
+  /// Finds the path between two points on a bit grid but assumes that there
+  /// is only one path. Set bits are not path. The path is the same as the
+  /// path found on a Grid but straight corridors are skipped 64 tiles at a
+  /// time.
+  std::vector<Pos> onePath(const BitGrid &, Pos, Pos);
 }
 
 #include "one path.inl"
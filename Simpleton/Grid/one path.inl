@@ -8,9 +8,9 @@
 
 #include "dir.hpp"
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Function>
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
 std::vector<Grid::Pos> Grid::onePath(
-  const Grid<Tile, Width, Height> &grid,
+  const Grid<Tile, Width, Height, Layout> &grid,
   Function &&notPath,
   const Pos start,
   const Pos end
@@ -54,3 +54,114 @@ std::vector<Grid::Pos> Grid::onePath(
     }
   } while (true);
 }
+
+namespace Grid::detail {
+  inline BitGrid::Word onePathRow(const BitGrid &grid, const Pos pos) {
+    // rows outside of the grid are blocked
+    return grid.outOfRange(pos) ? ~BitGrid::Word{} : grid.rowBits(pos);
+  }
+  
+  inline BitGrid::Word onePathRowBefore(const BitGrid &grid, const Pos pos) {
+    return grid.outOfRange(pos) ? ~BitGrid::Word{} : grid.rowBitsBefore(pos);
+  }
+  
+  // The number of steps onePath would take in the same direction before it
+  // turns or stops. A step is repeated if the directions that are checked
+  // before it are blocked and the tile in front is open.
+  inline Coord onePathRun(const BitGrid &grid, const Pos pos, const Dir dir) {
+    constexpr Coord word_bits = static_cast<Coord>(BitGrid::word_bits);
+    Coord steps = 0;
+    switch (dir) {
+      case Dir::up:
+        // up is checked first so it is repeated until it is blocked
+        return grid.nextSetVert({pos.x, pos.y + 1}) - pos.y - 1;
+        
+      case Dir::right:
+        // up is checked before right
+        for (Coord x = pos.x; x < grid.width() - 1; x += word_bits) {
+          const BitGrid::Word run = onePathRow(grid, {x, pos.y + 1}) & ~grid.rowBits({x + 1, pos.y});
+          const Coord len = run == ~BitGrid::Word{} ? word_bits : __builtin_ctzll(~run);
+          steps += std::min(len, grid.width() - 1 - x);
+          if (len != word_bits) {
+            break;
+          }
+        }
+        return steps;
+        
+      case Dir::left:
+        // up and down are checked before left
+        for (Coord x = pos.x; x > 0; x -= word_bits) {
+          const BitGrid::Word run =
+            onePathRowBefore(grid, {x, pos.y + 1}) &
+            onePathRowBefore(grid, {x, pos.y - 1}) &
+            ~grid.rowBitsBefore({x - 1, pos.y});
+          const Coord len = run == ~BitGrid::Word{} ? word_bits : __builtin_clzll(~run);
+          steps += std::min(len, x);
+          if (len != word_bits) {
+            break;
+          }
+        }
+        return steps;
+        
+      default:
+        // columns can't be scanned a word at a time
+        return 0;
+    }
+  }
+}
+
+inline std::vector<Grid::Pos> Grid::onePath(
+  const BitGrid &grid,
+  const Pos start,
+  const Pos end
+) {
+  if (grid.outOfRange(start) || grid.outOfRange(end)) {
+    return {};
+  }
+  
+  Pos pos = start;
+  std::vector<Pos> path;
+  path.push_back(start);
+  Dir prevDir = Dir::none;
+  
+  do {
+    bool deadEnd = true;
+    
+    for (const Dir dir : dir_range) {
+      if (dir == opposite(prevDir)) {
+        continue;
+      }
+      
+      const Pos step = toVec<Coord>(dir);
+      const Pos neighPos = pos + step;
+      if (grid.outOfRange(neighPos) || grid[neighPos]) {
+        continue;
+      }
+      
+      path.push_back(neighPos);
+      if (neighPos == end) {
+        return path;
+      }
+      
+      deadEnd = false;
+      prevDir = dir;
+      pos = neighPos;
+      
+      // skip along the corridor
+      const Coord run = detail::onePathRun(grid, pos, dir);
+      for (Coord s = 0; s != run; ++s) {
+        pos += step;
+        path.push_back(pos);
+        if (pos == end) {
+          return path;
+        }
+      }
+      
+      break;
+    }
+    
+    if (deadEnd) {
+      return {};
+    }
+  } while (true);
+}
@@ -0,0 +1,129 @@
+//
+//  path cache.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_path_cache_hpp
+#define engine_grid_path_cache_hpp
+
+#include <vector>
+#include <unordered_map>
+#include "grid.hpp"
+
+namespace Grid {
+  /// Counters for measuring how well a PathCache is working
+  struct PathCacheStats {
+    /// Number of paths that were found in the cache
+    size_t hits = 0;
+    /// Number of paths that weren't found in the cache
+    size_t misses = 0;
+    /// Number of paths that were removed because a tile along them changed
+    size_t invalidations = 0;
+    /// Number of paths that were removed to make space for other paths
+    size_t evictions = 0;
+  };
+
+  /// A cache of paths keyed on the start, the end and an ID for the notPath
+  /// predicate. The cache is told when tiles change and a path is only thrown
+  /// away when a tile along it changes. This means that a cached path might
+  /// not be the shortest path if a shortcut has opened up. A cached empty path
+  /// (no path was found) is thrown away when any tile changes. Tiles are
+  /// grouped into square regions that each have a version so that checking
+  /// a path usually only needs to look at the regions it passes through. When
+  /// the cache is full, the least recently used path is evicted.
+  class PathCache {
+  public:
+    using PredID = uint32_t;
+    static constexpr Coord region_size = 16;
+
+    /// Create a cache for a grid of the given size that holds up to the given
+    /// number of paths
+    PathCache(Pos, size_t);
+
+    /// Get a cached path or null if the path isn't in the cache. The path is
+    /// valid until the cache is modified
+    const std::vector<Pos> *find(Pos, Pos, PredID = 0);
+    /// Put a path into the cache. Returns a reference to the cached path that
+    /// is valid until the cache is modified
+    const std::vector<Pos> &insert(Pos, Pos, PredID, std::vector<Pos>);
+    /// Get a cached path or call the search function with the start and the
+    /// end and put the result in the cache. Returns a reference to the cached
+    /// path that is valid until the cache is modified
+    template <typename Function>
+    const std::vector<Pos> &path(Pos, Pos, PredID, Function &&);
+
+    /// Tell the cache that a tile has changed
+    void changed(Pos);
+    /// Remove every path
+    void clear();
+
+    /// Number of cached paths
+    size_t size() const {
+      return lookup.size();
+    }
+    /// Maximum number of cached paths
+    size_t capacity() const {
+      return mCapacity;
+    }
+    const PathCacheStats &stats() const {
+      return mStats;
+    }
+    void resetStats() {
+      mStats = {};
+    }
+
+  private:
+    static constexpr uint32_t no_entry = ~uint32_t{};
+
+    struct Key {
+      Pos start;
+      Pos end;
+      PredID pred;
+
+      bool operator==(const Key &other) const {
+        return start == other.start && end == other.end && pred == other.pred;
+      }
+    };
+    struct KeyHash {
+      size_t operator()(const Key &) const;
+    };
+    struct Entry {
+      Key key;
+      std::vector<Pos> path;
+      // the regions that the path passes through
+      std::vector<uint32_t> regions;
+      // the version when the path was inserted
+      uint32_t version;
+      // neighbours in the least recently used list
+      uint32_t prev;
+      uint32_t next;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<uint32_t> freeEntries;
+    std::unordered_map<Key, uint32_t, KeyHash> lookup;
+    // the version when each tile and region last changed
+    Grid<uint32_t> tileVersions;
+    Grid<uint32_t> regionVersions;
+    uint32_t version = 0;
+    // most recently used
+    uint32_t head = no_entry;
+    // least recently used
+    uint32_t tail = no_entry;
+    size_t mCapacity;
+    PathCacheStats mStats;
+
+    size_t regionIndex(Pos) const;
+    bool valid(const Entry &) const;
+    void unlink(uint32_t);
+    void pushFront(uint32_t);
+    void erase(uint32_t);
+  };
+}
+
+#include "path cache.inl"
+
+#endif
@@ -0,0 +1,191 @@
+//
+//  path cache.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <functional>
+
+inline size_t Grid::PathCache::KeyHash::operator()(const Key &key) const {
+  const auto mix = [] (const size_t seed, const uint32_t value) {
+    return seed ^ (std::hash<uint32_t>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+  };
+  size_t seed = 0;
+  seed = mix(seed, static_cast<uint32_t>(key.start.x));
+  seed = mix(seed, static_cast<uint32_t>(key.start.y));
+  seed = mix(seed, static_cast<uint32_t>(key.end.x));
+  seed = mix(seed, static_cast<uint32_t>(key.end.y));
+  return mix(seed, key.pred);
+}
+
+inline Grid::PathCache::PathCache(const Pos size, const size_t capacity)
+  : tileVersions{size, 0},
+    regionVersions{
+      Pos{
+        (size.x + region_size - 1) / region_size,
+        (size.y + region_size - 1) / region_size
+      },
+      0
+    },
+    mCapacity{capacity} {
+  assert(capacity > 0);
+  entries.reserve(capacity);
+  lookup.reserve(capacity);
+}
+
+inline const std::vector<Grid::Pos> *Grid::PathCache::find(
+  const Pos start,
+  const Pos end,
+  const PredID pred
+) {
+  const auto iter = lookup.find({start, end, pred});
+  if (iter == lookup.end()) {
+    ++mStats.misses;
+    return nullptr;
+  }
+  const uint32_t index = iter->second;
+  if (!valid(entries[index])) {
+    erase(index);
+    ++mStats.invalidations;
+    ++mStats.misses;
+    return nullptr;
+  }
+  unlink(index);
+  pushFront(index);
+  ++mStats.hits;
+  return &entries[index].path;
+}
+
+inline const std::vector<Grid::Pos> &Grid::PathCache::insert(
+  const Pos start,
+  const Pos end,
+  const PredID pred,
+  std::vector<Pos> path
+) {
+  const Key key = {start, end, pred};
+  uint32_t index;
+  if (const auto iter = lookup.find(key); iter != lookup.end()) {
+    index = iter->second;
+    unlink(index);
+  } else {
+    if (lookup.size() == mCapacity) {
+      erase(tail);
+      ++mStats.evictions;
+    }
+    if (freeEntries.empty()) {
+      index = static_cast<uint32_t>(entries.size());
+      entries.emplace_back();
+    } else {
+      index = freeEntries.back();
+      freeEntries.pop_back();
+    }
+    lookup.emplace(key, index);
+  }
+
+  Entry &entry = entries[index];
+  entry.key = key;
+  entry.path = std::move(path);
+  entry.version = version;
+  entry.regions.clear();
+  for (const Pos pos : entry.path) {
+    const uint32_t region = static_cast<uint32_t>(regionIndex(pos));
+    // paths are continuous so most repeated regions are next to each other
+    if (entry.regions.empty() || entry.regions.back() != region) {
+      entry.regions.push_back(region);
+    }
+  }
+  pushFront(index);
+  return entry.path;
+}
+
+template <typename Function>
+const std::vector<Grid::Pos> &Grid::PathCache::path(
+  const Pos start,
+  const Pos end,
+  const PredID pred,
+  Function &&search
+) {
+  if (const std::vector<Pos> *cached = find(start, end, pred)) {
+    return *cached;
+  }
+  return insert(start, end, pred, search(start, end));
+}
+
+inline void Grid::PathCache::changed(const Pos pos) {
+  if (++version == ~uint32_t{}) {
+    // the versions are about to wrap around
+    clear();
+    tileVersions.fill(0);
+    regionVersions.fill(0);
+    version = 1;
+  }
+  tileVersions[pos] = version;
+  regionVersions[regionIndex(pos)] = version;
+}
+
+inline void Grid::PathCache::clear() {
+  entries.clear();
+  freeEntries.clear();
+  lookup.clear();
+  head = no_entry;
+  tail = no_entry;
+}
+
+inline size_t Grid::PathCache::regionIndex(const Pos pos) const {
+  return regionVersions.toIndex(pos / region_size);
+}
+
+inline bool Grid::PathCache::valid(const Entry &entry) const {
+  if (entry.path.empty()) {
+    return entry.version == version;
+  }
+  for (const uint32_t region : entry.regions) {
+    if (regionVersions[region] > entry.version) {
+      // something in a region along the path has changed so check the tiles
+      for (const Pos pos : entry.path) {
+        if (tileVersions[pos] > entry.version) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return true;
+}
+
+inline void Grid::PathCache::unlink(const uint32_t index) {
+  Entry &entry = entries[index];
+  if (entry.prev == no_entry) {
+    head = entry.next;
+  } else {
+    entries[entry.prev].next = entry.next;
+  }
+  if (entry.next == no_entry) {
+    tail = entry.prev;
+  } else {
+    entries[entry.next].prev = entry.prev;
+  }
+}
+
+inline void Grid::PathCache::pushFront(const uint32_t index) {
+  Entry &entry = entries[index];
+  entry.prev = no_entry;
+  entry.next = head;
+  if (head == no_entry) {
+    tail = index;
+  } else {
+    entries[head].prev = index;
+  }
+  head = index;
+}
+
+inline void Grid::PathCache::erase(const uint32_t index) {
+  Entry &entry = entries[index];
+  unlink(index);
+  lookup.erase(entry.key);
+  entry.path = {};
+  entry.regions.clear();
+  freeEntries.push_back(index);
+}
@@ -0,0 +1,112 @@
+//
+//  regions.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_regions_hpp
+#define engine_grid_regions_hpp
+
+#include <array>
+#include <limits>
+#include "grid.hpp"
+#include "bit grid.hpp"
+
+namespace Grid {
+  using RegionID = uint32_t;
+  /// The region of tiles that are not path
+  constexpr RegionID no_region = std::numeric_limits<RegionID>::max();
+
+  namespace detail {
+    // Disjoint sets with union by rank. find doesn't modify the sets so it can
+    // be called from multiple threads. compress halves the path as it goes.
+    class UnionFind {
+    public:
+      void clear();
+      RegionID make();
+      RegionID find(RegionID) const;
+      RegionID compress(RegionID);
+      // returns the root of the merged set
+      RegionID unite(RegionID, RegionID);
+
+      size_t size() const {
+        return parent.size();
+      }
+
+    private:
+      std::vector<RegionID> parent;
+      std::vector<uint8_t> rank;
+    };
+  }
+
+  /// Label the connected regions of path tiles. Tiles are connected to the
+  /// four tiles around them. Tiles that are not path are no_region. Regions
+  /// are numbered from 0 in the order that they're first seen when scanning
+  /// from the bottom row to the top row. Two tiles are connected if they have
+  /// the same region.
+  template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+  Grid<RegionID, Width, Height, Layout> labelRegions(
+    const Grid<Tile, Width, Height, Layout> &,
+    Function &&
+  );
+
+  /// The connected regions of a grid that are kept up to date as tiles change.
+  /// Checking whether two tiles are connected doesn't need a search so an
+  /// unreachable goal can be rejected before calling astar. Turning a tile
+  /// into path merges regions in constant time. Turning a tile into not path
+  /// only searches the smaller side of a region that it might split. The
+  /// const member functions don't modify anything so they can be called from
+  /// multiple threads.
+  class RegionMap {
+  public:
+    RegionMap() = default;
+    template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+    RegionMap(const Grid<Tile, Width, Height, Layout> &, Function &&);
+    /// Set bits are not path
+    explicit RegionMap(const BitGrid &);
+
+    Pos size() const {
+      return labels.size();
+    }
+    bool outOfRange(const Pos pos) const {
+      return labels.outOfRange(pos);
+    }
+
+    /// Is the tile a path tile?
+    bool path(Pos) const;
+    /// Get the region of a tile. This is no_region if the tile isn't path.
+    /// Region IDs are not contiguous and change when tiles change
+    RegionID region(Pos) const;
+    /// Is there a path between two path tiles?
+    bool connected(Pos, Pos) const;
+    /// Number of connected regions
+    size_t numRegions() const {
+      return count;
+    }
+
+    /// Change a tile into a path tile or into a tile that isn't path
+    void setPath(Pos, bool = true);
+    /// Read a tile that has changed
+    template <typename Tile, Coord Width, Coord Height, typename Layout, typename Function>
+    void update(const Grid<Tile, Width, Height, Layout> &, Function &&, Pos);
+
+  private:
+    // each path tile has a label in the sets. Tiles with labels in the same
+    // set are in the same region
+    Grid<RegionID> labels;
+    detail::UnionFind sets;
+    std::array<std::vector<Pos>, 4> queues;
+    size_t count = 0;
+
+    void addTile(Pos);
+    void removeTile(Pos);
+    bool ringConnected(Pos) const;
+    void compact();
+  };
+}
+
+#include "regions.inl"
+
+#endif
@@ -0,0 +1,335 @@
+//
+//  regions.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#include <array>
+#include <algorithm>
+#include "dir.hpp"
+
+inline void Grid::detail::UnionFind::clear() {
+  parent.clear();
+  rank.clear();
+}
+
+inline Grid::RegionID Grid::detail::UnionFind::make() {
+  const RegionID id = static_cast<RegionID>(parent.size());
+  parent.push_back(id);
+  rank.push_back(0);
+  return id;
+}
+
+inline Grid::RegionID Grid::detail::UnionFind::find(RegionID id) const {
+  while (parent[id] != id) {
+    id = parent[id];
+  }
+  return id;
+}
+
+inline Grid::RegionID Grid::detail::UnionFind::compress(RegionID id) {
+  while (parent[id] != id) {
+    parent[id] = parent[parent[id]];
+    id = parent[id];
+  }
+  return id;
+}
+
+inline Grid::RegionID Grid::detail::UnionFind::unite(RegionID a, RegionID b) {
+  a = compress(a);
+  b = compress(b);
+  if (a == b) {
+    return a;
+  }
+  if (rank[a] < rank[b]) {
+    std::swap(a, b);
+  } else if (rank[a] == rank[b]) {
+    ++rank[a];
+  }
+  parent[b] = a;
+  return a;
+}
+
+namespace Grid::detail {
+  // The first pass of the labeller. Every path tile gets a label and the
+  // labels of neighbouring tiles are put in the same set.
+  template <typename Labels, typename Function>
+  void labelPass(Labels &labels, UnionFind &sets, Function &&notPath) {
+    for (const Coord y : labels.vert()) {
+      for (const Coord x : labels.hori()) {
+        RegionID &label = labels(x, y);
+        if (notPath(Pos{x, y})) {
+          label = no_region;
+          continue;
+        }
+        const RegionID left = x > 0 ? labels(x - 1, y) : no_region;
+        const RegionID down = y > 0 ? labels(x, y - 1) : no_region;
+        if (down != no_region) {
+          label = down;
+          if (left != no_region) {
+            sets.unite(left, down);
+          }
+        } else if (left != no_region) {
+          label = left;
+        } else {
+          label = sets.make();
+        }
+      }
+    }
+  }
+
+  // The second pass of the labeller. Every label is replaced with a new
+  // label for its set. New labels are numbered in scan order. Returns the
+  // number of sets.
+  template <typename Labels>
+  RegionID relabelPass(Labels &labels, const UnionFind &sets) {
+    std::vector<RegionID> ids(sets.size(), no_region);
+    RegionID next = 0;
+    for (const Coord y : labels.vert()) {
+      for (const Coord x : labels.hori()) {
+        RegionID &label = labels(x, y);
+        if (label == no_region) {
+          continue;
+        }
+        RegionID &id = ids[sets.find(label)];
+        if (id == no_region) {
+          id = next++;
+        }
+        label = id;
+      }
+    }
+    return next;
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::Grid<Grid::RegionID, Width, Height, Layout> Grid::labelRegions(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath
+) {
+  Grid<RegionID, Width, Height, Layout> labels{grid.size()};
+  detail::UnionFind sets;
+  detail::labelPass(labels, sets, [&grid, &notPath] (const Pos pos) {
+    return notPath(grid[pos]);
+  });
+  detail::relabelPass(labels, sets);
+  return labels;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+Grid::RegionMap::RegionMap(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath
+) : labels{grid.size()} {
+  detail::labelPass(labels, sets, [&grid, &notPath] (const Pos pos) {
+    return notPath(grid[pos]);
+  });
+  compact();
+}
+
+inline Grid::RegionMap::RegionMap(const BitGrid &walls)
+  : labels{walls.size()} {
+  detail::labelPass(labels, sets, [&walls] (const Pos pos) {
+    return walls[pos];
+  });
+  compact();
+}
+
+inline bool Grid::RegionMap::path(const Pos pos) const {
+  return labels[pos] != no_region;
+}
+
+inline Grid::RegionID Grid::RegionMap::region(const Pos pos) const {
+  const RegionID label = labels[pos];
+  return label == no_region ? no_region : sets.find(label);
+}
+
+inline bool Grid::RegionMap::connected(const Pos a, const Pos b) const {
+  const RegionID regionA = region(a);
+  return regionA != no_region && regionA == region(b);
+}
+
+inline void Grid::RegionMap::setPath(const Pos pos, const bool isPath) {
+  if (path(pos) == isPath) {
+    return;
+  }
+  // removing tiles leaves dead labels behind
+  if (sets.size() > 2 * static_cast<size_t>(size().x * size().y)) {
+    compact();
+  }
+  if (isPath) {
+    addTile(pos);
+  } else {
+    removeTile(pos);
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout, typename Function>
+void Grid::RegionMap::update(
+  const Grid<Tile, Width, Height, Layout> &grid,
+  Function &&notPath,
+  const Pos pos
+) {
+  assert(grid.size() == size());
+  setPath(pos, !notPath(grid[pos]));
+}
+
+inline void Grid::RegionMap::addTile(const Pos pos) {
+  RegionID root = sets.make();
+  labels[pos] = root;
+  ++count;
+  for (const Dir dir : dir_range) {
+    const Pos neighPos = pos + toVec<Coord>(dir);
+    if (outOfRange(neighPos) || !path(neighPos)) {
+      continue;
+    }
+    const RegionID neighRoot = sets.compress(labels[neighPos]);
+    if (neighRoot != root) {
+      root = sets.unite(root, neighRoot);
+      --count;
+    }
+  }
+}
+
+inline void Grid::RegionMap::removeTile(const Pos pos) {
+  const RegionID oldRoot = sets.compress(labels[pos]);
+  labels[pos] = no_region;
+
+  std::array<Pos, 4> neighs;
+  size_t numNeighs = 0;
+  for (const Dir dir : dir_range) {
+    const Pos neighPos = pos + toVec<Coord>(dir);
+    if (!outOfRange(neighPos) && path(neighPos)) {
+      neighs[numNeighs++] = neighPos;
+    }
+  }
+
+  if (numNeighs == 0) {
+    --count;
+    return;
+  }
+  if (numNeighs == 1 || ringConnected(pos)) {
+    return;
+  }
+
+  // The region might have been split. A search is started from each
+  // neighbour with a new label and the searches take turns visiting one tile.
+  // Searches that meet are merged. A search that runs out of tiles has found
+  // a whole region. When there is one search left, the tiles that it hasn't
+  // visited are in the same region as the tiles it has visited so the search
+  // can stop. This means that the work done is proportional to the size of
+  // the smaller regions. Labels from before the split are less than firstNew.
+  const RegionID firstNew = static_cast<RegionID>(sets.size());
+  std::array<RegionID, 4> searchLabel;
+  std::array<size_t, 4> head;
+  size_t active = numNeighs;
+  for (size_t s = 0; s != numNeighs; ++s) {
+    searchLabel[s] = sets.make();
+    head[s] = 0;
+    queues[s].clear();
+    queues[s].push_back(neighs[s]);
+    labels[neighs[s]] = searchLabel[s];
+  }
+
+  while (active > 1) {
+    for (size_t s = 0; s != numNeighs && active > 1; ++s) {
+      std::vector<Pos> &queue = queues[s];
+      if (head[s] == queue.size()) {
+        continue;
+      }
+      const Pos searchPos = queue[head[s]++];
+      const RegionID root = sets.compress(searchLabel[s]);
+      for (const Dir dir : dir_range) {
+        const Pos neighPos = searchPos + toVec<Coord>(dir);
+        if (outOfRange(neighPos) || !path(neighPos)) {
+          continue;
+        }
+        RegionID &label = labels[neighPos];
+        if (label < firstNew) {
+          label = searchLabel[s];
+          queue.push_back(neighPos);
+          continue;
+        }
+        const RegionID otherRoot = sets.compress(label);
+        if (otherRoot == root) {
+          continue;
+        }
+        // take over the other search
+        for (size_t o = 0; o != numNeighs; ++o) {
+          if (o != s && head[o] != queues[o].size() && sets.compress(searchLabel[o]) == otherRoot) {
+            queue.insert(queue.end(), queues[o].cbegin() + static_cast<std::ptrdiff_t>(head[o]), queues[o].cend());
+            head[o] = queues[o].size();
+            --active;
+          }
+        }
+        sets.unite(root, otherRoot);
+      }
+      if (head[s] == queue.size()) {
+        // found a whole region
+        ++count;
+        --active;
+      }
+    }
+  }
+
+  // the last search joins the tiles that it didn't visit
+  for (size_t s = 0; s != numNeighs; ++s) {
+    if (head[s] != queues[s].size()) {
+      sets.unite(searchLabel[s], oldRoot);
+    }
+  }
+}
+
+// Are the path tiles next to a tile connected by the tiles around the tile?
+// If they are then removing the tile doesn't split a region
+inline bool Grid::RegionMap::ringConnected(const Pos pos) const {
+  // The tiles around a tile in order. Neighbouring tiles in the ring are
+  // neighbours on the grid so the path tiles in the ring form runs of
+  // connected tiles. Odd tiles are next to the center tile.
+  constexpr Pos ring[8] = {
+    {-1, -1}, {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}
+  };
+  bool isPath[8];
+  size_t start = 8;
+  for (size_t r = 0; r != 8; ++r) {
+    const Pos ringPos = pos + ring[r];
+    isPath[r] = !outOfRange(ringPos) && path(ringPos);
+    if (!isPath[r]) {
+      start = r;
+    }
+  }
+  if (start == 8) {
+    return true;
+  }
+
+  // start at a tile that isn't path so that runs don't wrap around
+  size_t run = 0;
+  size_t neighRun = 0;
+  for (size_t i = 1; i <= 8; ++i) {
+    const size_t r = (start + i) % 8;
+    if (!isPath[r]) {
+      continue;
+    }
+    if (!isPath[(r + 7) % 8]) {
+      ++run;
+    }
+    if (r % 2 == 1) {
+      if (neighRun == 0) {
+        neighRun = run;
+      } else if (neighRun != run) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+inline void Grid::RegionMap::compact() {
+  count = detail::relabelPass(labels, sets);
+  sets.clear();
+  for (RegionID r = 0; r != count; ++r) {
+    sets.make();
+  }
+}
@@ -0,0 +1,122 @@
+//
+//  stencil.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_grid_stencil_hpp
+#define engine_grid_stencil_hpp
+
+#include "grid.hpp"
+#include "../Utils/parallel for.hpp"
+
+namespace Grid {
+  /// The tiles around a tile that a stencil kernel can read. (0, 0) is the
+  /// tile being updated and the offsets go from -1 to 1 on each axis. Tiles
+  /// outside of the grid are the border tile of the stencil.
+  template <typename Tile>
+  class Neighborhood {
+  public:
+    Neighborhood(const Pos pos, const Tile *below, const Tile *row, const Tile *above)
+      : mPos{pos}, rows{below, row, above} {}
+
+    /// Position of the tile being updated
+    Pos pos() const {
+      return mPos;
+    }
+    const Tile &operator()(const Coord x, const Coord y) const {
+      assert(-1 <= x && x <= 1);
+      assert(-1 <= y && y <= 1);
+      return rows[y + 1][x];
+    }
+    const Tile &operator[](const Pos offset) const {
+      return (*this)(offset.x, offset.y);
+    }
+    /// The tile being updated
+    const Tile &center() const {
+      return rows[1][0];
+    }
+
+  private:
+    Pos mPos;
+    // each pointer points to the center column
+    const Tile *rows[3];
+  };
+
+  /// Runs a kernel over every tile of a grid at the same time, like a cellular
+  /// automaton. The kernel takes a Neighborhood and returns the new value of
+  /// the tile. Tiles are read from one grid and written to another so the
+  /// kernel always sees the previous step. The grid is split into square
+  /// blocks and a block is only updated if it or one of the blocks around it
+  /// changed during the previous step. Blocks that have settled are skipped.
+  /// Tiles in the middle of the grid are read straight from the rows so a
+  /// simple kernel on arithmetic tiles can be vectorized by the compiler.
+  template <typename Tile>
+  class Stencil {
+  public:
+    static_assert(detail::contiguous_tiles<Tile, runtime>, "Stencil needs contiguous rows");
+
+    /// Start with a grid. Tiles outside of the grid are the border tile. The
+    /// block size is the number of tiles on each side of a block
+    explicit Stencil(Grid<Tile>, const Tile & = {}, Coord = 32);
+
+    /// The result of the latest step
+    const Grid<Tile> &grid() const {
+      return front;
+    }
+    Pos size() const {
+      return front.size();
+    }
+    const Tile &operator[](const Pos pos) const {
+      return front[pos];
+    }
+    /// Change a tile between steps. The blocks around the tile are woken up
+    void set(Pos, const Tile &);
+    /// Update every block in the next step. Call this if the kernel changes
+    void wake();
+
+    /// Number of blocks that will be updated in the next step
+    size_t activeBlocks() const {
+      return active.size();
+    }
+    /// Have all of the blocks settled?
+    bool settled() const {
+      return active.empty();
+    }
+
+    /// Update the active blocks
+    template <typename Kernel>
+    void step(Kernel &&);
+    /// Update the active blocks using multiple threads. The kernel is called
+    /// from multiple threads at the same time so it must not modify anything
+    template <typename Kernel>
+    void step(Utils::parallel_t, Kernel &&, unsigned = 0);
+
+  private:
+    Grid<Tile> front;
+    Grid<Tile> back;
+    // the border row with a tile of padding on each side
+    std::vector<Tile> borderRow;
+    Tile border;
+    Coord blockSize;
+    Pos numBlocks;
+    // indicies of the blocks to update in the next step
+    std::vector<uint32_t> active;
+    std::vector<uint32_t> stepped;
+    // whether each block changed in the current step
+    std::vector<uint8_t> changed;
+    std::vector<uint8_t> woken;
+
+    const Tile *row(Coord) const;
+    void wakeAround(Pos);
+    template <typename Kernel>
+    bool stepBlock(uint32_t, Kernel &);
+    void finishStep();
+  };
+}
+
+#include "stencil.inl"
+
+#endif
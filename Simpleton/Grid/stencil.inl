@@ -0,0 +1,163 @@
+//
+//  stencil.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+template <typename Tile>
+Grid::Stencil<Tile>::Stencil(Grid<Tile> grid, const Tile &border, const Coord blockSize)
+  : front{std::move(grid)},
+    back{front},
+    borderRow(static_cast<size_t>(front.width()) + 2, border),
+    border{border},
+    blockSize{blockSize} {
+  assert(blockSize > 0);
+  numBlocks = {
+    (front.width() + blockSize - 1) / blockSize,
+    (front.height() + blockSize - 1) / blockSize
+  };
+  const size_t count = static_cast<size_t>(numBlocks.x) * static_cast<size_t>(numBlocks.y);
+  changed.resize(count, 0);
+  woken.resize(count, 0);
+  wake();
+}
+
+template <typename Tile>
+void Grid::Stencil<Tile>::set(const Pos pos, const Tile &tile) {
+  // settled blocks have the same tiles in both grids and that has to stay
+  // true for the blocks that aren't woken up
+  front[pos] = tile;
+  back[pos] = tile;
+  wakeAround({pos.x / blockSize, pos.y / blockSize});
+}
+
+template <typename Tile>
+void Grid::Stencil<Tile>::wake() {
+  active.clear();
+  for (uint32_t b = 0; b != woken.size(); ++b) {
+    active.push_back(b);
+    woken[b] = 1;
+  }
+}
+
+template <typename Tile>
+template <typename Kernel>
+void Grid::Stencil<Tile>::step(Kernel &&kernel) {
+  for (const uint32_t block : active) {
+    changed[block] = stepBlock(block, kernel);
+  }
+  finishStep();
+}
+
+template <typename Tile>
+template <typename Kernel>
+void Grid::Stencil<Tile>::step(Utils::parallel_t, Kernel &&kernel, const unsigned threads) {
+  // blocks don't share any tiles in the grid being written to
+  Utils::parallelFor(0, active.size(), [this, &kernel] (const size_t a) {
+    changed[active[a]] = stepBlock(active[a], kernel);
+  }, threads);
+  finishStep();
+}
+
+template <typename Tile>
+const Tile *Grid::Stencil<Tile>::row(const Coord y) const {
+  if (y < 0 || y >= front.height()) {
+    return borderRow.data() + 1;
+  } else {
+    return front.data() + static_cast<size_t>(y) * static_cast<size_t>(front.width());
+  }
+}
+
+template <typename Tile>
+void Grid::Stencil<Tile>::wakeAround(const Pos block) {
+  // a tile on the edge of a block is read by the blocks next to it
+  const Coord minX = std::max(block.x - 1, Coord{0});
+  const Coord minY = std::max(block.y - 1, Coord{0});
+  const Coord maxX = std::min(block.x + 1, numBlocks.x - 1);
+  const Coord maxY = std::min(block.y + 1, numBlocks.y - 1);
+  for (Coord y = minY; y <= maxY; ++y) {
+    for (Coord x = minX; x <= maxX; ++x) {
+      const uint32_t index = static_cast<uint32_t>(y * numBlocks.x + x);
+      if (!woken[index]) {
+        woken[index] = 1;
+        active.push_back(index);
+      }
+    }
+  }
+}
+
+template <typename Tile>
+template <typename Kernel>
+bool Grid::Stencil<Tile>::stepBlock(const uint32_t block, Kernel &kernel) {
+  const Coord width = front.width();
+  const Pos min = {
+    static_cast<Coord>(block % static_cast<uint32_t>(numBlocks.x)) * blockSize,
+    static_cast<Coord>(block / static_cast<uint32_t>(numBlocks.x)) * blockSize
+  };
+  const Pos max = {
+    std::min(min.x + blockSize, width),
+    std::min(min.y + blockSize, front.height())
+  };
+  // the first and last columns read outside of the row so they are copied
+  // into a small neighborhood with the border tile
+  const Coord beginX = std::max(min.x, Coord{1});
+  const Coord endX = std::min(max.x, width - 1);
+  bool blockChanged = false;
+
+  const auto edge = [&] (const Pos pos, Tile *const out) {
+    Tile local[3][3];
+    for (Coord y = -1; y <= 1; ++y) {
+      for (Coord x = -1; x <= 1; ++x) {
+        const Pos neigh = {pos.x + x, pos.y + y};
+        local[y + 1][x + 1] = front.outOfRange(neigh) ? border : front[neigh];
+      }
+    }
+    *out = kernel(Neighborhood<Tile>{pos, local[0] + 1, local[1] + 1, local[2] + 1});
+    blockChanged |= !(*out == local[1][1]);
+  };
+
+  for (Coord y = min.y; y != max.y; ++y) {
+    const Tile *const below = row(y - 1);
+    const Tile *const middle = row(y);
+    const Tile *const above = row(y + 1);
+    Tile *const out = back.data() + static_cast<size_t>(y) * static_cast<size_t>(width);
+
+    if (min.x == 0) {
+      edge({0, y}, out);
+    }
+    // keep this loop simple so that it can be vectorized. The comparison
+    // is done separately
+    for (Coord x = beginX; x < endX; ++x) {
+      out[x] = kernel(Neighborhood<Tile>{{x, y}, below + x, middle + x, above + x});
+    }
+    if (beginX < endX && !blockChanged) {
+      blockChanged = !std::equal(out + beginX, out + endX, middle + beginX);
+    }
+    if (max.x == width && width > 1) {
+      edge({width - 1, y}, out + (width - 1));
+    }
+  }
+  return blockChanged;
+}
+
+template <typename Tile>
+void Grid::Stencil<Tile>::finishStep() {
+  std::swap(front, back);
+  // a block that didn't change has the same tiles in both grids. It wakes up
+  // if a block next to it changes
+  stepped.swap(active);
+  active.clear();
+  for (const uint32_t block : stepped) {
+    woken[block] = 0;
+  }
+  for (const uint32_t block : stepped) {
+    if (changed[block]) {
+      wakeAround({
+        static_cast<Coord>(block % static_cast<uint32_t>(numBlocks.x)),
+        static_cast<Coord>(block / static_cast<uint32_t>(numBlocks.x))
+      });
+    }
+  }
+}
@@ -12,23 +12,51 @@
 #include "grid.hpp"
 
 namespace Grid {
-  template <typename Tile, Coord Width, Coord Height>
-  Grid<Tile, Width, Height> flip_x(const Grid<Tile, Width, Height> &);
+  /// Row major grids are flipped a row at a time with std::reverse_copy which
+  /// the compiler vectorizes. This also applies to flip_xy and the inplace
+  /// versions. Grids with other layouts are transformed one tile at a time
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  Grid<Tile, Width, Height, Layout> flip_x(const Grid<Tile, Width, Height, Layout> &);
   
-  template <typename Tile, Coord Width, Coord Height>
-  Grid<Tile, Width, Height> flip_y(const Grid<Tile, Width, Height> &);
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  Grid<Tile, Width, Height, Layout> flip_y(const Grid<Tile, Width, Height, Layout> &);
   
-  template <typename Tile, Coord Width, Coord Height>
-  Grid<Tile, Height, Width> transpose(const Grid<Tile, Width, Height> &);
+  /// Transpose in cache-sized blocks
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  Grid<Tile, Height, Width, Layout> transpose(const Grid<Tile, Width, Height, Layout> &);
   
-  template <typename Tile, Coord Width, Coord Height>
-  auto flip_xy(const Grid<Tile, Width, Height> &);
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  auto flip_xy(const Grid<Tile, Width, Height, Layout> &);
   
-  template <typename Tile, Coord Width, Coord Height>
-  auto rot_x2y(const Grid<Tile, Width, Height> &);
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  auto rot_x2y(const Grid<Tile, Width, Height, Layout> &);
   
-  template <typename Tile, Coord Width, Coord Height>
-  auto rot_y2x(const Grid<Tile, Width, Height> &);
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  auto rot_y2x(const Grid<Tile, Width, Height, Layout> &);
+  
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  void flip_x_inplace(Grid<Tile, Width, Height, Layout> &);
+  
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  void flip_y_inplace(Grid<Tile, Width, Height, Layout> &);
+  
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  void flip_xy_inplace(Grid<Tile, Width, Height, Layout> &);
+  
+  /// Transpose without allocating a new grid. Static grids must be square.
+  /// Non-square dynamic grids are transposed by following permutation cycles
+  /// which allocates one bit per tile to remember which tiles have been moved.
+  /// The cycles jump all over memory so this is slower than copying with
+  /// transpose (148ms vs 65ms on a 4096x2048 grid). Only use it on non-square
+  /// grids when memory is tight.
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  void transpose_inplace(Grid<Tile, Width, Height, Layout> &);
+  
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  void rot_x2y_inplace(Grid<Tile, Width, Height, Layout> &);
+  
+  template <typename Tile, Coord Width, Coord Height, typename Layout>
+  void rot_y2x_inplace(Grid<Tile, Width, Height, Layout> &);
 }
 
 #include "transform.inl"
@@ -6,6 +6,9 @@
 //  Copyright © 2018 Indi Kernick. All rights reserved.
 //
 
+#include <array>
+#include <algorithm>
+
 #define TRANSFORM(...)                                                          \
   for (const Coord y : in.vert()) {                                             \
     for (const Coord x : in.hori()) {                                           \
@@ -13,40 +16,272 @@
     }                                                                           \
   }
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height>
-Grid::Grid<Tile, Width, Height> Grid::flip_x(const Grid<Tile, Width, Height> &in) {
-  Grid<Tile, Width, Height> out{in.size()};
-  TRANSFORM(out(in.width() - x - 1, y) = in(x, y))
+namespace Grid::detail {
+  // tiles per side of the blocks used by transpose
+  constexpr Coord transpose_block = 32;
+
+  template <typename Tile>
+  void copyRow(Tile *dst, const Tile *src, const size_t size) {
+    // memmove for trivially copyable tiles
+    std::copy(src, src + size, dst);
+  }
+
+  // transpose a block of a grid into a block of another grid
+  template <typename Tile>
+  void transposeBlock(
+    Tile *dst,
+    const Tile *src,
+    const Coord width,
+    const Coord height,
+    const Pos min,
+    const Pos max
+  ) {
+    for (Coord y = min.y; y != max.y; ++y) {
+      const Tile *srcRow = src + static_cast<size_t>(y) * static_cast<size_t>(width);
+      for (Coord x = min.x; x != max.x; ++x) {
+        dst[static_cast<size_t>(x) * static_cast<size_t>(height) + static_cast<size_t>(y)] = srcRow[x];
+      }
+    }
+  }
+
+  // transpose a square grid in place
+  template <typename Tile>
+  void transposeSquare(Tile *tiles, const Coord size) {
+    using std::swap;
+    const size_t stride = static_cast<size_t>(size);
+    for (Coord by = 0; by < size; by += transpose_block) {
+      const Coord ey = std::min(by + transpose_block, size);
+      // blocks on the diagonal swap with themselves
+      for (Coord y = by; y != ey; ++y) {
+        for (Coord x = y + 1; x < ey; ++x) {
+          swap(tiles[y * stride + x], tiles[x * stride + y]);
+        }
+      }
+      // blocks above the diagonal swap with blocks below the diagonal
+      for (Coord bx = ey; bx < size; bx += transpose_block) {
+        const Coord ex = std::min(bx + transpose_block, size);
+        for (Coord y = by; y != ey; ++y) {
+          for (Coord x = bx; x != ex; ++x) {
+            swap(tiles[y * stride + x], tiles[x * stride + y]);
+          }
+        }
+      }
+    }
+  }
+
+  // transpose a non-square grid in place by following permutation cycles.
+  // Finding the start of each cycle without marking moved tiles would mean
+  // walking the cycle again for every tile. The function gives the index
+  // that the tile at an index moves to
+  template <typename Tile, typename Function>
+  void transposeCycles(Tile *tiles, const size_t area, Function next) {
+    using std::swap;
+    std::vector<bool> moved(area, false);
+    for (size_t start = 0; start != area; ++start) {
+      if (moved[start]) {
+        continue;
+      }
+      Tile carry = std::move(tiles[start]);
+      size_t index = start;
+      do {
+        const size_t dst = next(index);
+        swap(carry, tiles[dst]);
+        moved[dst] = true;
+        index = dst;
+      } while (index != start);
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+Grid::Grid<Tile, Width, Height, Layout> Grid::flip_x(const Grid<Tile, Width, Height, Layout> &in) {
+  Grid<Tile, Width, Height, Layout> out{in.size()};
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    const size_t width = static_cast<size_t>(in.width());
+    for (const Coord y : in.vert()) {
+      const size_t row = static_cast<size_t>(y) * width;
+      const Tile *const src = in.data() + row;
+      std::reverse_copy(src, src + width, out.data() + row);
+    }
+  } else {
+    TRANSFORM(out(in.width() - x - 1, y) = in(x, y))
+  }
   return out;
 }
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height>
-Grid::Grid<Tile, Width, Height> Grid::flip_y(const Grid<Tile, Width, Height> &in) {
-  Grid<Tile, Width, Height> out{in.size()};
-  TRANSFORM(out(x, in.height() - y - 1) = in(x, y))
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+Grid::Grid<Tile, Width, Height, Layout> Grid::flip_y(const Grid<Tile, Width, Height, Layout> &in) {
+  Grid<Tile, Width, Height, Layout> out{in.size()};
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    const size_t width = static_cast<size_t>(in.width());
+    for (const Coord y : in.vert()) {
+      detail::copyRow(
+        out.data() + static_cast<size_t>(in.height() - y - 1) * width,
+        in.data() + static_cast<size_t>(y) * width,
+        width
+      );
+    }
+  } else {
+    TRANSFORM(out(x, in.height() - y - 1) = in(x, y))
+  }
   return out;
 }
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height>
-Grid::Grid<Tile, Height, Width> Grid::transpose(const Grid<Tile, Width, Height> &in) {
-  Grid<Tile, Height, Width> out{{in.height(), in.width()}};
-  TRANSFORM(out(y, x) = in(x, y))
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+Grid::Grid<Tile, Height, Width, Layout> Grid::transpose(const Grid<Tile, Width, Height, Layout> &in) {
+  Grid<Tile, Height, Width, Layout> out{Pos{in.height(), in.width()}};
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    constexpr Coord block = detail::transpose_block;
+    for (Coord by = 0; by < in.height(); by += block) {
+      for (Coord bx = 0; bx < in.width(); bx += block) {
+        detail::transposeBlock(
+          out.data(),
+          in.data(),
+          in.width(),
+          in.height(),
+          {bx, by},
+          {std::min(bx + block, in.width()), std::min(by + block, in.height())}
+        );
+      }
+    }
+  } else {
+    TRANSFORM(out(y, x) = in(x, y))
+  }
+  return out;
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+auto Grid::flip_xy(const Grid<Tile, Width, Height, Layout> &in) {
+  Grid<Tile, Width, Height, Layout> out{in.size()};
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    // flipping both axes reverses the whole grid
+    std::reverse_copy(in.data(), in.data() + in.area(), out.data());
+  } else {
+    TRANSFORM(out(in.width() - x - 1, in.height() - y - 1) = in(x, y))
+  }
   return out;
 }
 
 #undef TRANSFORM
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height>
-auto Grid::flip_xy(const Grid<Tile, Width, Height> &in) {
-  return flip_x(flip_y(in));
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+auto Grid::rot_x2y(const Grid<Tile, Width, Height, Layout> &in) {
+  return transpose(flip_x(in));
 }
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height>
-auto Grid::rot_x2y(const Grid<Tile, Width, Height> &in) {
-  return transpose(flip_x(in));
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+auto Grid::rot_y2x(const Grid<Tile, Width, Height, Layout> &in) {
+  return transpose(flip_y(in));
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+void Grid::flip_x_inplace(Grid<Tile, Width, Height, Layout> &grid) {
+  static_assert(detail::contiguous_tiles<Tile, Width>, "Use flip_x for std::vector<bool>");
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    const size_t width = static_cast<size_t>(grid.width());
+    for (const Coord y : grid.vert()) {
+      Tile *const row = grid.data() + static_cast<size_t>(y) * width;
+      std::reverse(row, row + width);
+    }
+  } else {
+    using std::swap;
+    for (const Coord y : grid.vert()) {
+      for (Coord x = 0; x < grid.width() / 2; ++x) {
+        swap(grid(x, y), grid(grid.width() - x - 1, y));
+      }
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+void Grid::flip_y_inplace(Grid<Tile, Width, Height, Layout> &grid) {
+  static_assert(detail::contiguous_tiles<Tile, Width>, "Use flip_y for std::vector<bool>");
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    const size_t width = static_cast<size_t>(grid.width());
+    for (Coord y = 0; y < grid.height() / 2; ++y) {
+      Tile *const bottom = grid.data() + static_cast<size_t>(y) * width;
+      Tile *const top = grid.data() + static_cast<size_t>(grid.height() - y - 1) * width;
+      std::swap_ranges(bottom, bottom + width, top);
+    }
+  } else {
+    using std::swap;
+    for (Coord y = 0; y < grid.height() / 2; ++y) {
+      for (const Coord x : grid.hori()) {
+        swap(grid(x, y), grid(x, grid.height() - y - 1));
+      }
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+void Grid::flip_xy_inplace(Grid<Tile, Width, Height, Layout> &grid) {
+  static_assert(detail::contiguous_tiles<Tile, Width>, "Use flip_xy for std::vector<bool>");
+  if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+    std::reverse(grid.data(), grid.data() + grid.area());
+  } else {
+    using std::swap;
+    const Pos last = grid.size() - Pos{1, 1};
+    for (Coord y = 0; y < grid.height() / 2; ++y) {
+      for (const Coord x : grid.hori()) {
+        swap(grid(x, y), grid[last - Pos{x, y}]);
+      }
+    }
+    // the middle row of a grid with an odd height
+    if (grid.height() % 2 == 1) {
+      const Coord y = grid.height() / 2;
+      for (Coord x = 0; x < grid.width() / 2; ++x) {
+        swap(grid(x, y), grid(last.x - x, y));
+      }
+    }
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+void Grid::transpose_inplace(Grid<Tile, Width, Height, Layout> &grid) {
+  static_assert(detail::contiguous_tiles<Tile, Width>, "Use transpose for std::vector<bool>");
+  if constexpr (Width != runtime) {
+    static_assert(Width == Height, "Static grids must be square to be transposed in place");
+  }
+  if (grid.width() == grid.height()) {
+    if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+      detail::transposeSquare(grid.data(), grid.width());
+    } else {
+      using std::swap;
+      for (const Coord y : grid.vert()) {
+        for (Coord x = y + 1; x < grid.width(); ++x) {
+          swap(grid(x, y), grid(y, x));
+        }
+      }
+    }
+  } else if constexpr (Width == runtime) {
+    const Pos size = grid.size();
+    const Pos transSize = {size.y, size.x};
+    if constexpr (detail::row_major_tiles<Tile, Width, Layout>) {
+      const size_t w = static_cast<size_t>(size.x);
+      const size_t h = static_cast<size_t>(size.y);
+      detail::transposeCycles(grid.data(), grid.area(), [w, h] (const size_t index) {
+        // tile (x, y) moves to (y, x)
+        return (index % w) * h + index / w;
+      });
+    } else {
+      detail::transposeCycles(grid.data(), grid.area(), [size, transSize] (const size_t index) {
+        const Pos pos = Layout::toPos(index, size);
+        return Layout::toIndex({pos.y, pos.x}, transSize);
+      });
+    }
+    // the area doesn't change so the tiles are not touched
+    grid.resize(transSize);
+  }
+}
+
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+void Grid::rot_x2y_inplace(Grid<Tile, Width, Height, Layout> &grid) {
+  flip_x_inplace(grid);
+  transpose_inplace(grid);
 }
 
-template <typename Tile, Grid::Coord Width, Grid::Coord Height>
-auto Grid::rot_y2x(const Grid<Tile, Width, Height> &in) {
-  return tranpose(flip_y(in));
+template <typename Tile, Grid::Coord Width, Grid::Coord Height, typename Layout>
+void Grid::rot_y2x_inplace(Grid<Tile, Width, Height, Layout> &grid) {
+  flip_y_inplace(grid);
+  transpose_inplace(grid);
 }
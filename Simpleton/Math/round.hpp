@@ -223,6 +223,28 @@ namespace Math {
     return num / den + (((num < 0) ^ (den > 0)) && (num % den));
   }
   
+  ///Compute the floor of the division of num and den
+  template <typename Num, typename Den>
+  constexpr std::enable_if_t<
+    std::is_unsigned<Num>::value &&
+    std::is_unsigned<Den>::value,
+    std::common_type_t<Num, Den>
+  >
+  divFloor(const Num num, const Den den) {
+    return num / den;
+  }
+  
+  ///Compute the floor of the division of num and den
+  template <typename Num, typename Den>
+  constexpr std::enable_if_t<
+    std::is_signed<Num>::value ||
+    std::is_signed<Den>::value,
+    std::common_type_t<Num, Den>
+  >
+  divFloor(const Num num, const Den den) {
+    return num / den - (((num < 0) ^ (den < 0)) && (num % den));
+  }
+  
   ///Compute the round of the division of num and den
   template <typename Num, typename Den>
   constexpr std::enable_if_t<
@@ -23,6 +23,13 @@ namespace GL {
   
     COUNT
   };
+  
+  /// An attribute type with a mode for attribsMode
+  template <typename Type, AttribMode MODE = AttribMode::NO_CHANGE>
+  struct Attrib {
+    using type = Type;
+    static constexpr AttribMode mode = MODE;
+  };
 
   namespace detail {
     template <typename T, bool INT, bool NORM>
@@ -49,6 +56,16 @@ namespace GL {
       }
     }
     
+    template <typename T, bool = std::is_arithmetic_v<T>>
+    struct Scalar {
+      using type = T;
+    };
+    
+    template <typename T>
+    struct Scalar<T, false> {
+      using type = Utils::vec_value_type<T>;
+    };
+    
     template <typename T, AttribMode MODE>
     void attribPointerVec(const GLint attr, const size_t stride, const size_t offset) {
       static_assert(
@@ -58,9 +75,9 @@ namespace GL {
       static_assert(static_cast<unsigned>(MODE) < static_cast<unsigned>(AttribMode::COUNT));
       
       if constexpr (MODE == AttribMode::NO_CHANGE) {
-        if constexpr (std::is_floating_point_v<T> || std::is_floating_point_v<Utils::vec_value_type<T>>) {
+        if constexpr (std::is_floating_point_v<typename Scalar<T>::type>) {
           attribPointerVecImpl<T, false, false>(attr, stride, offset);
-        } else if constexpr (std::is_integral_v<T> || std::is_integral_v<Utils::vec_value_type<T>>) {
+        } else if constexpr (std::is_integral_v<typename Scalar<T>::type>) {
           attribPointerVecImpl<T, true, false>(attr, stride, offset);
         }
       } else if constexpr (MODE == AttribMode::TO_FLOAT) {
@@ -111,14 +128,19 @@ namespace GL {
       }
     }
     
+    template <typename Attrib, typename = void>
+    struct GetMode {
+      static constexpr AttribMode value = AttribMode::NO_CHANGE;
+    };
+    
     template <typename Attrib>
-    constexpr auto getMode() -> decltype(Attrib::mode) {
-      return Attrib::mode;
-    }
+    struct GetMode<Attrib, std::void_t<decltype(Attrib::mode)>> {
+      static constexpr AttribMode value = Attrib::mode;
+    };
     
-    template <typename>
+    template <typename Attrib>
     constexpr AttribMode getMode() {
-      return AttribMode::NO_CHANGE;
+      return GetMode<Attrib>::value;
     }
   }
   
@@ -160,16 +182,18 @@ namespace GL {
   
   /// Calls glVertexAttribPointer and glEnableVertexAttribArray for all of the
   /// attributes in the type list. Stride and offset is set such that all of the
-  /// attributes are in the same buffer
-  template <typename Attribs>
-  void attribs() {
-    size_t currentOffset = 0;
+  /// attributes are in the same buffer. Every attribute uses the same mode. The
+  /// offset of the first attribute can be given to start reading from an
+  /// element other than the first
+  template <typename Attribs, AttribMode MODE = AttribMode::NO_CHANGE>
+  void attribs(const size_t offset = 0) {
+    size_t currentOffset = offset;
     GLint currentID = 0;
     List::forEach<Attribs>([&currentOffset, &currentID] (auto t) {
       constexpr size_t stride = List::ByteSize<Attribs>;
       using AttribType = LIST_TYPE(t);
       
-      detail::attribPointer<AttribType, AttribMode::NO_CHANGE>(currentID, stride, currentOffset);
+      detail::attribPointer<AttribType, MODE>(currentID, stride, currentOffset);
       
       const GLint endID = currentID + detail::numAttrLocations<AttribType>();
       for (; currentID != endID; ++currentID) {
@@ -183,16 +207,17 @@ namespace GL {
   
   /// Calls glVertexAttribPointer and glEnableVertexAttribArray for all of the
   /// attributes in the type list. Stride and offset is set such that all of the
-  /// attributes are in the same buffer
+  /// attributes are in the same buffer. The offset of the first attribute can
+  /// be given to start reading from an element other than the first
   template <typename Attribs>
-  void attribsMode() {
+  void attribsMode(const size_t offset = 0) {
     size_t stride = 0;
     List::forEach<Attribs>([&stride] (auto t) {
       using Attrib = LIST_TYPE(t);
       stride += sizeof(typename Attrib::type);
     });
   
-    size_t currentOffset = 0;
+    size_t currentOffset = offset;
     GLint currentID = 0;
     List::forEach<Attribs>([&currentOffset, &currentID, stride] (auto t) {
       using Attrib = LIST_TYPE(t);
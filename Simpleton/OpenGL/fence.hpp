@@ -0,0 +1,41 @@
+//
+//  fence.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_opengl_fence_hpp
+#define engine_opengl_fence_hpp
+
+#include "opengl.hpp"
+#include "../Utils/generic raii.hpp"
+
+namespace GL {
+  namespace detail {
+    void deleteFence(const GLsync &);
+  }
+  
+  class Fence {
+  public:
+    UTILS_RAII_CLASS_FULL(Fence, GLsync, sync, detail::deleteFence)
+    
+    /// Check whether the GPU has passed the fence without waiting
+    bool signaled() const;
+    /// Wait until the GPU has passed the fence. A null fence is always
+    /// signaled
+    void wait() const;
+  
+  private:
+    GLsync sync;
+  };
+  
+  /// Insert a fence into the command stream after all of the commands that
+  /// have been issued so far
+  Fence makeFence();
+}
+
+#include "fence.inl"
+
+#endif
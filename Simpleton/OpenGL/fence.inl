@@ -0,0 +1,40 @@
+//
+//  fence.inl
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+inline void GL::detail::deleteFence(const GLsync &sync) {
+  glDeleteSync(sync);
+  
+  CHECK_OPENGL_ERROR();
+}
+
+inline bool GL::Fence::signaled() const {
+  if (sync == nullptr) {
+    return true;
+  }
+  const GLenum status = glClientWaitSync(sync, 0, 0);
+  CHECK_OPENGL_ERROR();
+  return status != GL_TIMEOUT_EXPIRED;
+}
+
+inline void GL::Fence::wait() const {
+  if (sync == nullptr) {
+    return;
+  }
+  // the first wait flushes so that the fence is guaranteed to be reached
+  GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+  while (glClientWaitSync(sync, flags, 1'000'000) == GL_TIMEOUT_EXPIRED) {
+    flags = 0;
+  }
+  CHECK_OPENGL_ERROR();
+}
+
+inline GL::Fence GL::makeFence() {
+  const GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  CHECK_OPENGL_ERROR();
+  return Fence(sync);
+}
@@ -0,0 +1,48 @@
+//
+//  parallel for.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_utils_parallel_for_hpp
+#define engine_utils_parallel_for_hpp
+
+#include "worker pool.hpp"
+
+namespace Utils {
+  /// Tag for selecting the multi-threaded overload of a function
+  struct parallel_t {};
+  constexpr parallel_t parallel {};
+
+  /// Call a function with every index in the range [begin, end) spread across
+  /// a number of threads. The work is done by the shared pool so threads
+  /// aren't created for each call. The calling thread does some of the work
+  /// and the function returns when all of the indicies have been visited. The
+  /// order that indicies are visited in is unspecified. 0 threads means one
+  /// thread per core and there are never more threads than cores. If the
+  /// pool is already in use (by another thread or because this is called from
+  /// inside another parallelFor) then the calling thread does all of the work
+  template <typename Function>
+  void parallelFor(
+    const size_t begin,
+    const size_t end,
+    Function &&function,
+    const unsigned threads = 0
+  ) {
+    if (begin >= end) {
+      return;
+    }
+    const auto work = [&] (const size_t i, unsigned) {
+      function(begin + i);
+    };
+    if (end - begin == 1 || numThreads(threads) == 1 || !sharedPool().tryRun(end - begin, work, threads)) {
+      for (size_t i = begin; i != end; ++i) {
+        function(i);
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,195 @@
+//
+//  worker pool.hpp
+//  Simpleton Engine
+//
+//  Created by Indi Kernick on 16/10/26.
+//  Copyright © 2026 Indi Kernick. All rights reserved.
+//
+
+#ifndef engine_utils_worker_pool_hpp
+#define engine_utils_worker_pool_hpp
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <condition_variable>
+
+namespace Utils {
+  /// Get the number of threads to use. 0 means one thread per core
+  inline unsigned numThreads(const unsigned threads = 0) {
+    if (threads != 0) {
+      return threads;
+    }
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  /// A fixed number of threads that wait for work. The threads are created
+  /// once and reused for every call to run. The function is told which worker
+  /// is calling it so that each worker can have its own buffers. The calling
+  /// thread is worker 0.
+  class WorkerPool {
+  public:
+    /// Create a pool with a number of workers (including the calling thread).
+    /// 0 means one worker per core
+    explicit WorkerPool(const unsigned workers = 0) {
+      const unsigned count = numThreads(workers);
+      threads.reserve(count - 1);
+      for (unsigned w = 1; w < count; ++w) {
+        threads.emplace_back([this, w] {
+          work(w);
+        });
+      }
+    }
+    ~WorkerPool() {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+      }
+      wake.notify_all();
+      for (std::thread &thread : threads) {
+        thread.join();
+      }
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /// Number of workers including the calling thread
+    unsigned size() const {
+      return static_cast<unsigned>(threads.size()) + 1;
+    }
+
+    /// Call a function with every index in the range [0, count) and the index
+    /// of the worker that is calling it. The function returns when all of the
+    /// indicies have been visited. At most the given number of workers take
+    /// part and 0 means all of them. Calls from different threads take turns.
+    /// Don't call run from inside the function.
+    template <typename Function>
+    void run(const size_t count, Function &&function, const unsigned workers = 0) {
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        available.wait(lock, [this] {
+          return !inUse;
+        });
+        inUse = true;
+      }
+      runImpl(count, function, workers);
+      release();
+    }
+
+    /// Same as run except that if another thread is using the pool, this
+    /// returns false immediately instead of waiting for its turn. This can be
+    /// called from inside the function.
+    template <typename Function>
+    bool tryRun(const size_t count, Function &&function, const unsigned workers = 0) {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (inUse) {
+          return false;
+        }
+        inUse = true;
+      }
+      runImpl(count, function, workers);
+      release();
+      return true;
+    }
+
+  private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::condition_variable available;
+    // set for the duration of a call to run
+    bool inUse = false;
+    // incremented for each call to run so that workers know there's work
+    uint64_t generation = 0;
+    // number of workers that haven't finished the current call to run
+    unsigned busy = 0;
+    bool stopping = false;
+
+    std::atomic<size_t> next{0};
+    size_t jobCount = 0;
+    unsigned jobWorkers = 0;
+    void *jobFunction = nullptr;
+    void (*jobInvoke)(void *, size_t, unsigned) = nullptr;
+
+    template <typename Function>
+    void runImpl(const size_t count, Function &function, const unsigned workers) {
+      if (count == 0) {
+        return;
+      }
+      jobCount = count;
+      jobWorkers = workers == 0 ? size() : workers;
+      jobFunction = const_cast<void *>(static_cast<const void *>(&function));
+      jobInvoke = [] (void *const function, const size_t index, const unsigned worker) {
+        (*static_cast<std::remove_reference_t<Function> *>(function))(index, worker);
+      };
+      next.store(0, std::memory_order_relaxed);
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        busy = static_cast<unsigned>(threads.size());
+        ++generation;
+      }
+      wake.notify_all();
+      drain(0);
+      std::unique_lock<std::mutex> lock{mutex};
+      done.wait(lock, [this] {
+        return busy == 0;
+      });
+    }
+
+    void release() {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        inUse = false;
+      }
+      available.notify_one();
+    }
+
+    void drain(const unsigned worker) {
+      if (worker >= jobWorkers) {
+        return;
+      }
+      size_t i;
+      while ((i = next.fetch_add(1, std::memory_order_relaxed)) < jobCount) {
+        jobInvoke(jobFunction, i, worker);
+      }
+    }
+
+    void work(const unsigned worker) {
+      uint64_t seen = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock{mutex};
+          wake.wait(lock, [this, seen] {
+            return stopping || generation != seen;
+          });
+          if (stopping) {
+            return;
+          }
+          seen = generation;
+        }
+        drain(worker);
+        {
+          std::lock_guard<std::mutex> lock{mutex};
+          if (--busy == 0) {
+            done.notify_one();
+          }
+        }
+      }
+    }
+  };
+
+  /// The pool that parallelFor uses. It has one worker per core and it's
+  /// created the first time it's used
+  inline WorkerPool &sharedPool() {
+    static WorkerPool pool;
+    return pool;
+  }
+}
+
+#endif
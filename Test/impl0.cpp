@@ -155,6 +155,7 @@
 #include "../Simpleton/OpenGL/shader.hpp"
 #include "../Simpleton/OpenGL/type enum.hpp"
 #include "../Simpleton/OpenGL/shader program.hpp"
+#include "../Simpleton/OpenGL/fence.hpp"
 #include "../Simpleton/Grid/dir.hpp"
 #include "../Simpleton/Grid/transform.hpp"
 #include "../Simpleton/Grid/grid.hpp"
@@ -166,3 +167,21 @@
 #include "../Simpleton/Grid/morton.hpp"
 #include "../Simpleton/Grid/blit.hpp"
 #include "../Simpleton/Grid/one path.hpp"
+#include "../Simpleton/Grid/jump point search.hpp"
+#include "../Simpleton/Grid/hierarchical a star.hpp"
+#include "../Simpleton/Utils/parallel for.hpp"
+#include "../Simpleton/Utils/worker pool.hpp"
+#include "../Simpleton/Grid/flow field.hpp"
+#include "../Simpleton/Grid/layout.hpp"
+#include "../Simpleton/Grid/chunked grid.hpp"
+#include "../Simpleton/Grid/bit grid.hpp"
+#include "../Simpleton/Grid/regions.hpp"
+#include "../Simpleton/Grid/distance transform.hpp"
+#include "../Simpleton/Grid/path cache.hpp"
+#include "../Simpleton/Grid/a star batch.hpp"
+#include "../Simpleton/Grid/field of view.hpp"
+#include "../Simpleton/Grid/corridor graph.hpp"
+#include "../Simpleton/Grid/stencil.hpp"
+#include "../Simpleton/Grid/neighbor masks.hpp"
+#include "../Simpleton/Grid/layered grid.hpp"
+#include "../Simpleton/Grid/cow grid.hpp"